@@ -0,0 +1,29 @@
+#ifndef CORPUS_H
+#define CORPUS_H
+
+#include <vector>
+
+#include "Bench.h"
+#include "Board.h"
+#include "Init.h"
+
+namespace Corpus {
+
+	// Boards of the bench positions, a mix of opening, middlegame, endgame and puzzle positions.
+	// Benchmarks run over every board so results reflect positions met in search
+	inline std::vector<SandalBot::Board>& boards() {
+		static std::vector<SandalBot::Board> corpus = [] {
+			SandalBot::initGlobals();
+
+			std::vector<SandalBot::Board> result(SandalBot::Bench::positionCount);
+			for (std::size_t i = 0; i < result.size(); i++) {
+				result[i].loadPosition(SandalBot::Bench::positions[i]);
+			}
+			return result;
+		}();
+		return corpus;
+	}
+
+}
+
+#endif
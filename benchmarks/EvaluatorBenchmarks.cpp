@@ -0,0 +1,45 @@
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "Board.h"
+#include "Corpus.h"
+#include "Evaluator.h"
+
+using namespace SandalBot;
+
+// Full evaluation over the corpus, items are positions
+static void BM_Evaluate(benchmark::State& state) {
+	std::vector<Board>& boards = Corpus::boards();
+	Evaluator evaluator;
+
+	for (auto _ : state) {
+		for (Board& board : boards) {
+			benchmark::DoNotOptimize(evaluator.Evaluate(&board));
+		}
+	}
+	state.SetItemsProcessed(state.iterations() * boards.size());
+}
+BENCHMARK(BM_Evaluate);
+
+// Single evaluation terms over the corpus. Attack information is cached on each board after the
+// first iteration, as it is when move generation has already computed it during search
+static void BM_EvaluateTerm(benchmark::State& state, Evaluator::Term term) {
+	std::vector<Board>& boards = Corpus::boards();
+	Evaluator evaluator;
+
+	for (auto _ : state) {
+		for (Board& board : boards) {
+			benchmark::DoNotOptimize(evaluator.evaluateTerm(&board, term));
+		}
+	}
+	state.SetItemsProcessed(state.iterations() * boards.size());
+}
+BENCHMARK_CAPTURE(BM_EvaluateTerm, staticPieces, Evaluator::STATIC_PIECES);
+BENCHMARK_CAPTURE(BM_EvaluateTerm, pawnIslands, Evaluator::PAWN_ISLANDS);
+BENCHMARK_CAPTURE(BM_EvaluateTerm, passedPawns, Evaluator::PASSED_PAWNS);
+BENCHMARK_CAPTURE(BM_EvaluateTerm, kingSafety, Evaluator::KING_SAFETY);
+BENCHMARK_CAPTURE(BM_EvaluateTerm, mobility, Evaluator::MOBILITY);
+BENCHMARK_CAPTURE(BM_EvaluateTerm, threats, Evaluator::THREATS);
+BENCHMARK_CAPTURE(BM_EvaluateTerm, openFiles, Evaluator::OPEN_FILES);
+BENCHMARK_CAPTURE(BM_EvaluateTerm, openDiagonals, Evaluator::OPEN_DIAGONALS);
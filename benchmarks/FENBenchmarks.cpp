@@ -0,0 +1,38 @@
+#include <string_view>
+
+#include <benchmark/benchmark.h>
+
+#include "Bench.h"
+#include "Board.h"
+#include "Corpus.h"
+#include "FEN.h"
+
+using namespace SandalBot;
+
+// Parses every corpus FEN, items are positions
+static void BM_FenToPosition(benchmark::State& state) {
+	Corpus::boards(); // Initialises globals
+
+	for (auto _ : state) {
+		for (std::string_view fen : Bench::positions) {
+			benchmark::DoNotOptimize(FEN::fenToPosition(fen));
+		}
+	}
+	state.SetItemsProcessed(state.iterations() * Bench::positions.size());
+}
+BENCHMARK(BM_FenToPosition);
+
+// Parses and loads every corpus FEN onto a board, including hashing and piece list setup
+static void BM_LoadPosition(benchmark::State& state) {
+	Corpus::boards(); // Initialises globals
+	Board board;
+
+	for (auto _ : state) {
+		for (std::string_view fen : Bench::positions) {
+			board.loadPosition(fen);
+			benchmark::DoNotOptimize(board);
+		}
+	}
+	state.SetItemsProcessed(state.iterations() * Bench::positions.size());
+}
+BENCHMARK(BM_LoadPosition);
@@ -0,0 +1,85 @@
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "AttackInfo.h"
+#include "Board.h"
+#include "Corpus.h"
+#include "MoveGen.h"
+#include "MoveOrderer.h"
+#include "Types.h"
+
+using namespace SandalBot;
+
+// Generation of each move slice over the corpus, items are positions
+template <GenType Gen>
+static void BM_Generate(benchmark::State& state) {
+	std::vector<Board>& boards = Corpus::boards();
+	std::vector<MoveGen> generators;
+	for (Board& board : boards) {
+		generators.emplace_back(&board);
+	}
+
+	uint64_t moves = 0ULL;
+	MovePoint list[MoveGen::maxMoves];
+	for (auto _ : state) {
+		for (MoveGen& generator : generators) {
+			int numMoves = generator.generate<Gen>(list);
+			benchmark::DoNotOptimize(list);
+			moves += numMoves;
+		}
+	}
+	state.SetItemsProcessed(state.iterations() * boards.size());
+	state.counters["moves"] = benchmark::Counter(double(moves), benchmark::Counter::kIsRate);
+}
+BENCHMARK_TEMPLATE(BM_Generate, LEGAL);
+BENCHMARK_TEMPLATE(BM_Generate, CAPTURES);
+BENCHMARK_TEMPLATE(BM_Generate, QUIETS);
+BENCHMARK_TEMPLATE(BM_Generate, PSEUDO_LEGAL);
+
+// Makes and unmakes every legal move of the corpus, items are move pairs
+static void BM_MakeUnmakeMove(benchmark::State& state) {
+	std::vector<Board>& boards = Corpus::boards();
+	std::vector<std::vector<Move>> moveLists;
+	for (Board& board : boards) {
+		MoveGen generator(&board);
+		MovePoint list[MoveGen::maxMoves];
+		int numMoves = generator.generate(list);
+
+		std::vector<Move> moves;
+		for (int i = 0; i < numMoves; i++) {
+			moves.push_back(list[i].move);
+		}
+		moveLists.push_back(moves);
+	}
+
+	uint64_t pairs = 0ULL;
+	for (auto _ : state) {
+		for (std::size_t i = 0; i < boards.size(); i++) {
+			for (Move move : moveLists[i]) {
+				boards[i].makeMove(move);
+				boards[i].unMakeMove();
+			}
+			pairs += moveLists[i].size();
+		}
+		benchmark::ClobberMemory();
+	}
+	state.SetItemsProcessed(pairs);
+}
+BENCHMARK(BM_MakeUnmakeMove);
+
+// Computes attack information from scratch, the cost move generation and evaluation share per position
+static void BM_AttackInfoCompute(benchmark::State& state) {
+	std::vector<Board>& boards = Corpus::boards();
+
+	AttackInfo info;
+	for (auto _ : state) {
+		for (const Board& board : boards) {
+			info.compute(&board);
+			info.computeSideToMove(&board);
+			benchmark::DoNotOptimize(info);
+		}
+	}
+	state.SetItemsProcessed(state.iterations() * boards.size());
+}
+BENCHMARK(BM_AttackInfoCompute);
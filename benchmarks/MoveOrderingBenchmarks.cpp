@@ -0,0 +1,90 @@
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "Board.h"
+#include "Corpus.h"
+#include "MoveGen.h"
+#include "MoveOrderer.h"
+
+using namespace SandalBot;
+
+namespace {
+
+	using MoveList = std::vector<MovePoint>;
+
+	// Legal moves of every corpus position scored by the move orderer, then shuffled
+	// so each sort starts from the same realistic but unordered values
+	const std::vector<MoveList>& scoredMoveLists() {
+		static const std::vector<MoveList> lists = [] {
+			std::mt19937 rng(20240501U);
+			std::vector<MoveList> result;
+			MoveOrderer orderer;
+
+			for (Board& board : Corpus::boards()) {
+				MoveGen generator(&board);
+				MovePoint moves[MoveGen::maxMoves];
+				int numMoves = generator.generate(moves);
+				orderer.order(&board, moves, Move(), numMoves, 0);
+
+				MoveList list(moves, moves + numMoves);
+				std::shuffle(list.begin(), list.end(), rng);
+				result.push_back(list);
+			}
+			return result;
+		}();
+		return lists;
+	}
+
+}
+
+// Sorts each scored move list with a sorting variant, items are move lists. Copying
+// the list back to its unsorted order is included in every variant
+template <typename Sort>
+static void BM_SortMoves(benchmark::State& state, Sort sort) {
+	const std::vector<MoveList>& lists = scoredMoveLists();
+
+	MovePoint moves[MoveGen::maxMoves];
+	for (auto _ : state) {
+		for (const MoveList& list : lists) {
+			std::copy(list.begin(), list.end(), moves);
+			sort(moves, int(list.size()));
+			benchmark::DoNotOptimize(moves);
+		}
+	}
+	state.SetItemsProcessed(state.iterations() * lists.size());
+}
+BENCHMARK_CAPTURE(BM_SortMoves, quickSort, [](MovePoint moves[], int numMoves) { MoveOrderer::quickSort(moves, 0, numMoves); });
+BENCHMARK_CAPTURE(BM_SortMoves, bubbleSort, [](MovePoint moves[], int numMoves) { MoveOrderer::bubbleSort(moves, numMoves); });
+BENCHMARK_CAPTURE(BM_SortMoves, insertionSort, [](MovePoint moves[], int numMoves) { MoveOrderer::insertionSort(moves, numMoves); });
+BENCHMARK_CAPTURE(BM_SortMoves, selectionSort, [](MovePoint moves[], int numMoves) { MoveOrderer::selectionSort(moves, numMoves); });
+BENCHMARK_CAPTURE(BM_SortMoves, mergeSort, [](MovePoint moves[], int numMoves) { MoveOrderer::mergeSort(moves, 0, numMoves); });
+BENCHMARK_CAPTURE(BM_SortMoves, stdSort, [](MovePoint moves[], int numMoves) {
+	std::sort(moves, moves + numMoves, [](const MovePoint& a, const MovePoint& b) { return a.value > b.value; });
+});
+
+// Scores and sorts the legal moves of every corpus position as search does, items are positions
+static void BM_OrderMoves(benchmark::State& state) {
+	std::vector<Board>& boards = Corpus::boards();
+	std::vector<MoveList> lists;
+	for (Board& board : boards) {
+		MoveGen generator(&board);
+		MovePoint moves[MoveGen::maxMoves];
+		int numMoves = generator.generate(moves);
+		lists.emplace_back(moves, moves + numMoves);
+	}
+
+	MoveOrderer orderer;
+	MovePoint moves[MoveGen::maxMoves];
+	for (auto _ : state) {
+		for (std::size_t i = 0; i < boards.size(); i++) {
+			std::copy(lists[i].begin(), lists[i].end(), moves);
+			orderer.order(&boards[i], moves, Move(), int(lists[i].size()), 0);
+			benchmark::DoNotOptimize(moves);
+		}
+	}
+	state.SetItemsProcessed(state.iterations() * boards.size());
+}
+BENCHMARK(BM_OrderMoves);
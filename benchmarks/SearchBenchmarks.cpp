@@ -0,0 +1,50 @@
+#include <benchmark/benchmark.h>
+
+#include "Bench.h"
+#include "Board.h"
+#include "Corpus.h"
+#include "MoveOrderer.h"
+#include "Searcher.h"
+
+using namespace SandalBot;
+
+namespace {
+
+	// Boards searched per iteration, a slice of the corpus keeps deeper searches short
+	constexpr std::size_t searchedBoards{ 16 };
+
+	// A small table keeps clearing it between boards out of the measured time
+	constexpr int hashSizeMB{ 16 };
+
+}
+
+// Searches corpus boards to a fixed depth with a number of MultiPV lines, from an empty table
+// and fresh move ordering as bench does. Items are searched boards, so the ratio of the
+// MultiPV=4 and MultiPV=1 times is the cost of the extra lines at that depth
+static void BM_TimeToDepth(benchmark::State& state) {
+	int lines = int(state.range(0));
+	int depth = int(state.range(1));
+
+	Corpus::boards(); // Initialises globals
+	Board board;
+	Searcher searcher(&board);
+	searcher.changeHashSize(hashSizeMB);
+	searcher.setReportIterations(false);
+	searcher.setMultiPV(lines);
+
+	uint64_t nodes{ 0ULL };
+	for (auto _ : state) {
+		for (std::size_t i = 0; i < searchedBoards; i++) {
+			board.loadPosition(Bench::positions[i]);
+			searcher.clearHash();
+			searcher.orderer = MoveOrderer();
+
+			searcher.searchToDepth(depth);
+			nodes += searcher.nodes();
+			benchmark::DoNotOptimize(searcher.bestMove);
+		}
+	}
+	state.SetItemsProcessed(state.iterations() * searchedBoards);
+	state.counters["nodes"] = benchmark::Counter(double(nodes), benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(BM_TimeToDepth)->ArgNames({ "multipv", "depth" })->ArgsProduct({ { 1, 4 }, { 5, 7 } })->Unit(benchmark::kMillisecond);
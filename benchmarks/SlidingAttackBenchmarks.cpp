@@ -0,0 +1,180 @@
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "Bitboards.h"
+#include "Board.h"
+#include "Corpus.h"
+#include "Init.h"
+#include "KoggeStone.h"
+#include "MoveGen.h"
+#include "Types.h"
+
+using namespace SandalBot;
+
+namespace {
+
+	struct SliderSet {
+		Bitboard orthogonals;
+		Bitboard diagonals;
+		Bitboard occupied;
+	};
+
+	// Both sides' sliders of the standard perft positions
+	std::vector<SliderSet> loadSliderSets() {
+		static const char* fens[] = {
+			"rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+			"r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+			"8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+			"r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",
+			"rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8",
+			"r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 w - - 0 10",
+		};
+
+		initGlobals();
+		std::vector<SliderSet> sets;
+		Board board;
+		for (const char* fen : fens) {
+			board.loadPosition(fen);
+			for (Color c : { WHITE, BLACK }) {
+				Bitboard queens = board.typesBB[QUEEN] & board.colorsBB[c];
+				sets.push_back({
+					(board.typesBB[ROOK] & board.colorsBB[c]) | queens,
+					(board.typesBB[BISHOP] & board.colorsBB[c]) | queens,
+					board.typesBB[ALL_PIECES]
+				});
+			}
+		}
+		return sets;
+	}
+
+	const std::vector<SliderSet>& sliderSets() {
+		static const std::vector<SliderSet> sets = loadSliderSets();
+		return sets;
+	}
+
+}
+
+// Current approach, one magic lookup per slider
+static void BM_SlidingUnionMagics(benchmark::State& state) {
+	const std::vector<SliderSet>& sets = sliderSets();
+	for (auto _ : state) {
+		for (const SliderSet& set : sets) {
+			Bitboard attacks = 0ULL;
+			Bitboard orthogonals = set.orthogonals;
+			while (orthogonals != 0ULL) {
+				attacks |= getMovementBoard<ROOK>(popLSB(orthogonals), set.occupied);
+			}
+			Bitboard diagonals = set.diagonals;
+			while (diagonals != 0ULL) {
+				attacks |= getMovementBoard<BISHOP>(popLSB(diagonals), set.occupied);
+			}
+			benchmark::DoNotOptimize(attacks);
+		}
+	}
+	state.SetItemsProcessed(state.iterations() * sets.size());
+}
+BENCHMARK(BM_SlidingUnionMagics);
+
+static void BM_SlidingUnionKoggeStone(benchmark::State& state) {
+	const std::vector<SliderSet>& sets = sliderSets();
+	for (auto _ : state) {
+		for (const SliderSet& set : sets) {
+			Bitboard attacks = KoggeStone::orthogonalAttacks(set.orthogonals, ~set.occupied)
+				| KoggeStone::diagonalAttacks(set.diagonals, ~set.occupied);
+			benchmark::DoNotOptimize(attacks);
+		}
+	}
+	state.SetItemsProcessed(state.iterations() * sets.size());
+}
+BENCHMARK(BM_SlidingUnionKoggeStone);
+
+#if defined(__AVX2__)
+static void BM_SlidingUnionKoggeStoneAVX2(benchmark::State& state) {
+	const std::vector<SliderSet>& sets = sliderSets();
+	for (auto _ : state) {
+		for (const SliderSet& set : sets) {
+			Bitboard attacks = KoggeStone::orthogonalAttacksAVX2(set.orthogonals, ~set.occupied)
+				| KoggeStone::diagonalAttacksAVX2(set.diagonals, ~set.occupied);
+			benchmark::DoNotOptimize(attacks);
+		}
+	}
+	state.SetItemsProcessed(state.iterations() * sets.size());
+}
+BENCHMARK(BM_SlidingUnionKoggeStoneAVX2);
+#endif
+
+// Lookups from every square under the occupancy of every corpus position, with the
+// BitMagics::Backend given by the argument. Items are lookups
+template <PieceType Type>
+static void BM_SlidingLookup(benchmark::State& state) {
+	BitMagics::Backend backend = BitMagics::Backend(state.range(0));
+	if (backend == BitMagics::Backend::PEXT && !BitMagics::pextSupported()) {
+		state.SkipWithError("PEXT not supported");
+		return;
+	}
+
+	std::vector<Bitboard> occupancies;
+	for (const Board& board : Corpus::boards()) {
+		occupancies.push_back(board.typesBB[ALL_PIECES]);
+	}
+	setSlidingBackend(backend);
+
+	for (auto _ : state) {
+		for (Bitboard occupied : occupancies) {
+			for (Square square = START_SQUARE; square < SQUARES_NB; ++square) {
+				benchmark::DoNotOptimize(getMovementBoard<Type>(square, occupied));
+			}
+		}
+	}
+	state.SetItemsProcessed(state.iterations() * occupancies.size() * SQUARES_NB);
+
+	setSlidingBackend(BitMagics::pextSupported() ? BitMagics::Backend::PEXT : BitMagics::Backend::MAGIC);
+}
+BENCHMARK_TEMPLATE(BM_SlidingLookup, ROOK)->Arg(int(BitMagics::Backend::MAGIC))->Arg(int(BitMagics::Backend::PEXT));
+BENCHMARK_TEMPLATE(BM_SlidingLookup, BISHOP)->Arg(int(BitMagics::Backend::MAGIC))->Arg(int(BitMagics::Backend::PEXT));
+
+namespace {
+
+	uint64_t perft(Board& board, MoveGen& generator, int depth) {
+		MovePoint moves[MoveGen::maxMoves];
+		int numMoves = generator.generate(moves);
+		if (depth == 1) {
+			return numMoves;
+		}
+
+		uint64_t nodes = 0ULL;
+		for (int i = 0; i < numMoves; ++i) {
+			board.makeMove(moves[i].move);
+			nodes += perft(board, generator, depth - 1);
+			board.unMakeMove();
+		}
+		return nodes;
+	}
+
+}
+
+// Perft of kiwipete with each sliding attack backend, argument is the BitMagics::Backend
+static void BM_PerftSlidingBackend(benchmark::State& state) {
+	BitMagics::Backend backend = BitMagics::Backend(state.range(0));
+	if (backend == BitMagics::Backend::PEXT && !BitMagics::pextSupported()) {
+		state.SkipWithError("PEXT not supported");
+		return;
+	}
+
+	sliderSets(); // Initialises globals
+	setSlidingBackend(backend);
+
+	Board board;
+	board.loadPosition("r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1");
+	MoveGen generator(&board);
+
+	uint64_t nodes = 0ULL;
+	for (auto _ : state) {
+		nodes += perft(board, generator, 3);
+	}
+	state.counters["nps"] = benchmark::Counter(double(nodes), benchmark::Counter::kIsRate);
+
+	setSlidingBackend(BitMagics::pextSupported() ? BitMagics::Backend::PEXT : BitMagics::Backend::MAGIC);
+}
+BENCHMARK(BM_PerftSlidingBackend)->Arg(int(BitMagics::Backend::MAGIC))->Arg(int(BitMagics::Backend::PEXT))->Unit(benchmark::kMillisecond);
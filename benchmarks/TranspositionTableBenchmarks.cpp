@@ -0,0 +1,78 @@
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "Move.h"
+#include "TranspositionTable.h"
+#include "Types.h"
+
+using namespace SandalBot;
+
+namespace {
+
+	constexpr int tableSizeMB{ 16 };
+	constexpr int probeCount{ 4096 };
+
+	// Fills the percentage of table slots given by the benchmark argument with random keys, and
+	// returns probe keys of which half were stored. Keys are chosen for distinct random slots, as
+	// random keys alone would keep colliding and leave slots empty well short of the percentage
+	std::vector<HashKey> fillTable(TranspositionTable& table, int fillPercent) {
+		std::mt19937_64 rng(20240501ULL);
+
+		std::vector<std::size_t> slots(table.size);
+		std::iota(slots.begin(), slots.end(), std::size_t(0));
+		std::shuffle(slots.begin(), slots.end(), rng);
+
+		std::vector<HashKey> stored(table.size * fillPercent / 100);
+		for (std::size_t i = 0; i < stored.size(); i++) {
+			// Any key equal to the slot modulo the table size is stored in that slot
+			HashKey key = (rng() % (std::numeric_limits<HashKey>::max() / table.size)) * table.size + slots[i];
+			stored[i] = key == 0ULL ? table.size : key;
+			table.store(0, 4, 0, TranspositionTable::exact, Move(), stored[i]);
+		}
+
+		std::vector<HashKey> probes(probeCount);
+		for (int i = 0; i < probeCount; i++) {
+			probes[i] = (i % 2 == 0 && !stored.empty()) ? stored[rng() % stored.size()] : rng();
+		}
+		return probes;
+	}
+
+}
+
+// Lookups at the fill level in percent given by the argument, items are lookups
+static void BM_TranspositionLookup(benchmark::State& state) {
+	TranspositionTable table(tableSizeMB);
+	std::vector<HashKey> probes = fillTable(table, int(state.range(0)));
+	TranspositionTable::ProbeCounters counters;
+
+	for (auto _ : state) {
+		for (HashKey key : probes) {
+			benchmark::DoNotOptimize(table.lookup(4, 0, std::numeric_limits<int>::min() + 1, std::numeric_limits<int>::max(), key, counters));
+		}
+	}
+	state.SetItemsProcessed(state.iterations() * probes.size());
+	state.counters["hashfull"] = double(table.hashfull());
+}
+BENCHMARK(BM_TranspositionLookup)->Arg(0)->Arg(25)->Arg(50)->Arg(100);
+
+// Stores at the fill level in percent given by the argument, items are stores
+static void BM_TranspositionStore(benchmark::State& state) {
+	TranspositionTable table(tableSizeMB);
+	std::vector<HashKey> probes = fillTable(table, int(state.range(0)));
+
+	int16_t depth = 0;
+	for (auto _ : state) {
+		for (HashKey key : probes) {
+			table.store(0, depth, 0, TranspositionTable::lowerBound, Move(), key);
+		}
+		depth = (depth + 1) % 8;
+		benchmark::ClobberMemory();
+	}
+	state.SetItemsProcessed(state.iterations() * probes.size());
+}
+BENCHMARK(BM_TranspositionStore)->Arg(0)->Arg(25)->Arg(50)->Arg(100);
@@ -0,0 +1,51 @@
+#ifndef ATTACKINFO_H
+#define ATTACKINFO_H
+
+#include "Types.h"
+
+namespace SandalBot {
+
+	class Board;
+
+	// AttackInfo holds the attack maps, checks and pins of a single position. It is computed
+	// lazily once per node by Board and shared between move generation, evaluation and move ordering
+	struct AttackInfo {
+		// Squares attacked by each piece type of each color, ALL_PIECES holds the union
+		Bitboard attacks[COLOR_NB][PIECE_TYPE_NB]{};
+		// Squares attacked by the side not to move, seeing through the side to move's king.
+		// These are the squares the king cannot move to
+		Bitboard opponentAttacks{};
+		Bitboard checkers{}; // Enemy pieces giving check to the side to move
+		Bitboard checkMask{}; // Squares which capture or block a single checking piece
+		Bitboard pinned{}; // Friendly pieces pinned to the side to move's king
+		// Squares from which each piece type of the side to move would attack the enemy king
+		Bitboard checkSquares[PIECE_TYPE_NB]{};
+		// Pieces of the side to move which are the only blocker between one of its sliders and the
+		// enemy king, and discover a check when leaving the line
+		Bitboard discoveredCandidates{};
+
+		// Position the information was computed for
+		HashKey key{};
+		Bitboard occupied{};
+		bool valid{ false };
+		bool sideToMoveComputed{ false }; // Whether attacks of the side to move have been computed
+		bool checkSquaresComputed{ false }; // Whether check squares and discovered candidates have been computed
+
+		void compute(const Board* board);
+		void computeSideToMove(const Board* board);
+		void computeCheckSquares(const Board* board);
+
+		bool isCheck() const { return checkers != 0ULL; }
+		bool isDoubleCheck() const { return (checkers & (checkers - 1ULL)) != 0ULL; }
+	private:
+		template <Color Us>
+		void computeAttacks(const Board* board);
+		template <Color Us>
+		void computeCheckData(const Board* board);
+		template <Color Us>
+		void computeCheckSquares(const Board* board);
+	};
+
+}
+
+#endif // !ATTACKINFO_H
@@ -0,0 +1,37 @@
+#ifndef BENCH_H
+#define BENCH_H
+
+#include <array>
+#include <cstdint>
+#include <iostream>
+#include <string_view>
+
+namespace SandalBot {
+
+	// Bench searches a fixed suite of positions to a fixed depth and reports the total number of
+	// nodes searched. The total is a signature of the search, a change which leaves it unchanged
+	// did not alter the search tree. Every position is searched with a cleared hash table and
+	// move orderer, so the signature does not depend on the number of threads
+	namespace Bench {
+		constexpr int defaultDepth{ 8 };
+		constexpr int defaultThreads{ 1 };
+		constexpr int defaultHashSizeMB{ 16 };
+		constexpr int maxHashSizeMB{ 2000 }; // Maximum of the Hash option
+		constexpr std::size_t positionCount{ 64 };
+
+		// Start position, followed by the perft and puzzle positions of the test suite
+		extern const std::array<std::string_view, positionCount> positions;
+
+		// Total nodes and time taken by a bench run
+		struct Result {
+			uint64_t nodes{};
+			double seconds{};
+		};
+
+		Result run(int depth = defaultDepth, int threads = defaultThreads, int hashSizeMB = defaultHashSizeMB,
+			std::ostream& out = std::cout, bool perfCounters = false);
+	};
+
+}
+
+#endif // !BENCH_H
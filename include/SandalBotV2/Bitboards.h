@@ -6,6 +6,7 @@
 #include "Move.h"
 #include "Types.h"
 
+#include <array>
 #include <cstdint>
 #include <iostream>
 #include <limits>
@@ -27,37 +28,66 @@ namespace SandalBot {
 	constexpr Bitboard blockerRowMask{ 0b01111110ULL };
 	constexpr Bitboard blockerColumnMask{ 0x0001010101010100ULL };
 
-	extern uint8_t distances[SQUARES_NB][SQUARES_NB]; // Stores distance between any two coordinates
+	// Lookup tables are generated at compile time and placed in read-only memory
+	using SquareTable = std::array<Bitboard, SQUARES_NB>;
+
+	extern const std::array<std::array<uint8_t, SQUARES_NB>, SQUARES_NB> distances; // Stores distance between any two coordinates
 	// King and knight movement bitboards
 	// Pawn shield bitboard masks for king
-	extern Bitboard pawnShieldMask[COLOR_NB][SQUARES_NB];
+	extern const std::array<SquareTable, COLOR_NB> pawnShieldMask;
 	// Bitboards for attack zone around king
-	extern Bitboard kingAttackZone[COLOR_NB][SQUARES_NB];
+	extern const std::array<SquareTable, COLOR_NB> kingAttackZone;
 	// Bitboard attack zone for either white or black king
-	extern Bitboard kingUnbiasAttackZone[SQUARES_NB];
+	extern const SquareTable kingUnbiasAttackZone;
 	// Movement bitboards for attack moves for white and black pawns
-	extern Bitboard pawnAttackMoves[COLOR_NB][SQUARES_NB];
+	extern const std::array<SquareTable, COLOR_NB> pawnAttackMoves;
 	// Bitboard masks for white and black pawns for passed pawns.
 	// Masks pawn's column and adjacent columns in front of pawn
-	extern Bitboard passedPawnMasks[COLOR_NB][SQUARES_NB];
+	extern const std::array<SquareTable, COLOR_NB> passedPawnMasks;
 	// Bitboard masks for each column for pawn islands. (adjacent column masks)
-	extern Bitboard pawnIslandMasks[ROW_NB];
-	// Bitboard masks for all orthogonal and diagonal directions
-	extern Bitboard blockerOrthogonalMasks[SQUARES_NB];
-	extern Bitboard blockerDiagonalMasks[SQUARES_NB];
+	extern const std::array<Bitboard, ROW_NB> pawnIslandMasks;
 	// Masks for all rows and columns
-	extern Bitboard rowMasks[ROW_NB];
-	extern Bitboard columnMasks[COL_NB];
-	extern Bitboard forwardDiagonalMasks[15]; // 45 degree diagonals
-	extern Bitboard backwardDiagonalMasks[15]; // -45 degree diagonals
+	extern const std::array<Bitboard, ROW_NB> rowMasks;
+	extern const std::array<Bitboard, COL_NB> columnMasks;
+	extern const std::array<Bitboard, 15> forwardDiagonalMasks; // 45 degree diagonals
+	extern const std::array<Bitboard, 15> backwardDiagonalMasks; // -45 degree diagonals
+
+	extern const std::array<SquareTable, PIECE_TYPE_NB> movementBoards;
+
+	extern const std::array<SquareTable, SQUARES_NB> linesBB;
+	extern const std::array<SquareTable, SQUARES_NB> linesBetweenBB;
+
+	constexpr Bitboard getRowMask(const Square square) { return rowMask << (toRow(square) * 8); }
+	constexpr Bitboard getColMask(const Square square) { return columnMask << toCol(square); }
+
+	// Returns a bitmask of bounding box between two squares. Rows off the board wrap around
+	// like an x86 shift would, which the pawn shield masks of back rank kings rely upon
+	constexpr Bitboard boxMask(Square sq1, Square sq2) {
+		Bitboard horizontalMask = 0ULL;
+		Bitboard verticalMask = 0ULL;
+
+		Row row1 = toRow(sq1);
+		Column col1 = toCol(sq1);
 
-	extern Bitboard movementBoards[PIECE_TYPE_NB][SQUARES_NB];
+		Row row2 = toRow(sq2);
+		Column col2 = toCol(sq2);
 
-	extern Bitboard linesBB[SQUARES_NB][SQUARES_NB];
-	extern Bitboard linesBetweenBB[SQUARES_NB][SQUARES_NB];
+		Row rStart = row1 <= row2 ? row1 : row2;
+		Row rEnd = row1 <= row2 ? row2 : row1;
 
-	// Returns a bitmask of bounding box between two squares
-	Bitboard boxMask(Square sq1, Square sq2);
+		for (Row r = rStart; r <= rEnd; ++r) {
+			horizontalMask |= rowMask << ((r * ROW_NB) & 63);
+		}
+
+		Column cStart = col1 <= col2 ? col1 : col2;
+		Column cEnd = col1 <= col2 ? col2 : col1;
+
+		for (Column c = cStart; c <= cEnd; ++c) {
+			verticalMask |= getColMask(Square(c));
+		}
+
+		return horizontalMask & verticalMask;
+	}
 
 	inline Bitboard getBit(Bitboard bitboard, int index) {
 		return bitboard & (1ULL << index);
@@ -89,6 +119,11 @@ namespace SandalBot {
 		return static_cast<Square>(_tzcnt_u64(bitBoard));
 	}
 
+	// Returns the number of set bits in a bitboard
+	inline int popCount(Bitboard bitBoard) {
+		return static_cast<int>(_mm_popcnt_u64(bitBoard));
+	}
+
 	enum DistIndex : int {
 		NORTH_IDX = 0,
 		EAST_IDX,
@@ -108,14 +143,14 @@ namespace SandalBot {
 		END_DIAG = DISTINDEX_NB
 	};
 
-	inline DistIndex& operator++(DistIndex& d) { return d = DistIndex(int(d) + 1); }
+	constexpr DistIndex& operator++(DistIndex& d) { return d = DistIndex(int(d) + 1); }
 
 	struct dirDist {
 		// Distances between piece and sides of board
 		int slideDistances[DISTINDEX_NB]{};
 		bool knightSquares[DISTINDEX_NB]{};
-		dirDist() {}
-		dirDist(int top, int left, int right, int bottom);
+		constexpr dirDist() {}
+		constexpr dirDist(int top, int left, int right, int bottom);
 	};
 
 	constexpr Direction slideDirections[DISTINDEX_NB]{
@@ -136,15 +171,51 @@ namespace SandalBot {
 	inline Bitboard getLineBB(Square sq1, Square sq2) { return linesBB[sq1][sq2]; }
 	inline Bitboard getLineBetweenBB(Square sq1, Square sq2) { return linesBetweenBB[sq1][sq2]; }
 
-	inline Bitboard getForwardMask(const Square square) { return forwardDiagonalMasks[toRow(square) + toCol(square)]; }
-	inline Bitboard getBackwardMask(const Square square) { return backwardDiagonalMasks[7 + toRow(square) - toCol(square)]; }
-	inline Bitboard getRowMask(const Square square) { return rowMask << (toRow(square) * 8); }
-	inline Bitboard getColMask(const Square square) { return columnMask << toCol(square); }
-	inline Bitboard getBlockerOrthogonalMask(const Square square) { return blockerOrthogonalMasks[square]; }
-	inline Bitboard getBlockerDiagonalMask(const Square square) { return blockerDiagonalMasks[square]; }
+	constexpr Bitboard getForwardMask(const Square square) { return forwardDiagonalMasks[toRow(square) + toCol(square)]; }
+	constexpr Bitboard getBackwardMask(const Square square) { return backwardDiagonalMasks[7 + toRow(square) - toCol(square)]; }
+	inline Bitboard getBlockerOrthogonalMask(const Square square) { return BitMagics::orthogonalEntries[square].mask; }
+	inline Bitboard getBlockerDiagonalMask(const Square square) { return BitMagics::diagonalEntries[square].mask; }
 	inline Bitboard getOrthMovementBoard(const Square square, const Bitboard blockerBoard) { return BitMagics::getOrthogonalMovement(square, blockerBoard); }
 	inline Bitboard getDiagMovementBoard(const Square square, const Bitboard blockerBoard) { return BitMagics::getDiagonalMovement(square, blockerBoard); }
 
+	// Column masks used to prevent set-wise shifts wrapping around the board
+	constexpr Bitboard columnAMask{ columnMask };
+	constexpr Bitboard columnHMask{ columnMask << COL_H };
+
+	// Shifts every bit of a bitboard one square in a direction, discarding bits leaving the board
+	template <Direction D>
+	constexpr Bitboard shift(Bitboard bitboard) {
+		return D == NORTH ? bitboard >> 8
+			: D == SOUTH ? bitboard << 8
+			: D == EAST ? (bitboard & ~columnHMask) << 1
+			: D == WEST ? (bitboard & ~columnAMask) >> 1
+			: D == NORTH_EAST ? (bitboard & ~columnHMask) >> 7
+			: D == NORTH_WEST ? (bitboard & ~columnAMask) >> 9
+			: D == SOUTH_EAST ? (bitboard & ~columnHMask) << 9
+			: D == SOUTH_WEST ? (bitboard & ~columnAMask) << 7
+			: 0ULL;
+	}
+
+	// Returns all squares attacked by a set of pawns
+	template <Color Us>
+	constexpr Bitboard pawnAttacks(Bitboard pawns) {
+		return Us == WHITE ? shift<NORTH_WEST>(pawns) | shift<NORTH_EAST>(pawns)
+			: shift<SOUTH_WEST>(pawns) | shift<SOUTH_EAST>(pawns);
+	}
+
+	// Returns all squares attacked by a set of knights
+	constexpr Bitboard knightAttacks(Bitboard knights) {
+		Bitboard north = shift<NORTH>(knights);
+		Bitboard south = shift<SOUTH>(knights);
+		Bitboard east = shift<EAST>(knights);
+		Bitboard west = shift<WEST>(knights);
+
+		return shift<NORTH_EAST>(north) | shift<NORTH_WEST>(north)
+			| shift<SOUTH_EAST>(south) | shift<SOUTH_WEST>(south)
+			| shift<NORTH_EAST>(east) | shift<SOUTH_EAST>(east)
+			| shift<NORTH_WEST>(west) | shift<SOUTH_WEST>(west);
+	}
+
 	template <Color Us>
 	inline Bitboard getPawnAttackMoves(const Square square) { return pawnAttackMoves[Us][square]; }
 	template <Color Us>
@@ -164,15 +235,12 @@ namespace SandalBot {
 
 	template <>
 	inline Bitboard getMovementBoard<ROOK>(Square sq, Bitboard allPieces) {
-		Bitboard orthogonalBlockers = allPieces & getBlockerOrthogonalMask(sq);
-
-		return getOrthMovementBoard(sq, orthogonalBlockers);
+		return getOrthMovementBoard(sq, allPieces);
 	}
 
 	template <>
 	inline Bitboard getMovementBoard<BISHOP>(Square sq, Bitboard allPieces) {
-		Bitboard diagonalBlockers = allPieces & getBlockerDiagonalMask(sq);
-		return getDiagMovementBoard(sq, diagonalBlockers);
+		return getDiagMovementBoard(sq, allPieces);
 	}
 
 	template <>
@@ -181,6 +249,7 @@ namespace SandalBot {
 	}
 
 	void initBitboards();
+	void setSlidingBackend(BitMagics::Backend backend);
 
 }
 
@@ -1,7 +1,9 @@
 #ifndef BOARD_H
 #define BOARD_H
 
+#include "AttackInfo.h"
 #include "BoardHistory.h"
+#include "BoardState.h"
 #include "CoordHelper.h"
 #include "Move.h"
 #include "StateHistory.h"
@@ -11,8 +13,6 @@
 
 namespace SandalBot {
 
-	struct BoardState;
-
 	// Board class encapsulates the current and previous states of the board
 	// including piece positions, and previous positions
 	class Board {
@@ -37,18 +37,60 @@ namespace SandalBot {
 		int MMPieces[COLOR_NB]; // Number of major and minor pieces
 
 		Board();
+		Board(const Board& other);
+		Board& operator=(const Board& other);
 
 		void loadPosition(std::string_view fen);
 		void makeMove(Move move);
 		void unMakeMove();
 		void printBoard() const;
 		void printBitboards() const;
+		// Pieces of both colors attacking a square given an occupancy
+		Bitboard attackersTo(Square square, Bitboard occupied) const;
+		// Returns enemy pieces checking the side to move, computed once per position without full attack information
+		Bitboard checkers() {
+			if (!state->checkersComputed) {
+				state->checkers = attackersTo(kingSquares[mSideToMove], typesBB[ALL_PIECES]) & colorsBB[~mSideToMove];
+				state->checkersComputed = true;
+			}
+			return state->checkers;
+		}
+		// Whether a pseudo legal move leaves the own king safe, checking pins and king safety for this move only
+		bool isLegal(Move move);
+		// Whether a move, such as a transposition table or killer move, can be played pseudo legally in the position
+		bool isPseudoLegal(Move move) const;
+		// Returns attack information of the current position, computing it if it is out of date.
+		// Attacks of the side to move are only computed if bothSides is set, since legal move
+		// generation only requires the opponent's attacks
+		const AttackInfo& attacks(bool bothSides = false) {
+			if (!attackInfo.valid || attackInfo.key != state->zobristHash || attackInfo.occupied != typesBB[ALL_PIECES]) {
+				attackInfo.compute(this);
+			}
+			if (bothSides && !attackInfo.sideToMoveComputed) {
+				attackInfo.computeSideToMove(this);
+			}
+			return attackInfo;
+		}
+		// Returns attack information including the squares from which the side to move gives check
+		const AttackInfo& checkInfo() {
+			attacks();
+			if (!attackInfo.checkSquaresComputed) {
+				attackInfo.computeCheckSquares(this);
+			}
+			return attackInfo;
+		}
+		// Whether a legal move gives check, determined before the move is made
+		bool givesCheck(Move move) { return givesCheck(move, checkInfo()); }
+		// Whether a legal move gives check, using check information already taken from checkInfo()
+		bool givesCheck(Move move, const AttackInfo& info) const;
 		Color sideToMove() const { return mSideToMove; }
 		int moveCounter() const { return mMoveCounter; }
 	private:
 		Color mSideToMove;
 		int mMoveCounter{ 0 };
 
+		AttackInfo attackInfo{}; // Cached attack information of the most recently queried position
+
 		void initBitboards();
 
 		void movePiece(Square from, Square to);
@@ -10,7 +10,9 @@ namespace SandalBot {
 	class BoardHistory {
 	public:
 		BoardHistory();
+		BoardHistory(const BoardHistory& other);
 		~BoardHistory();
+		BoardHistory& operator=(const BoardHistory& other);
 		void push(HashKey value, bool reset);
 		void pop() { numBoards -= numBoards > 0 ? 1 : 0; }
 		bool contains(const HashKey key) const;
@@ -19,7 +19,8 @@ namespace SandalBot {
 
 		BoardState(BoardState&& other) noexcept
 			: capturedPiece(other.capturedPiece), enPassantSquare(other.enPassantSquare), cr(other.cr),
-			fiftyMoveCounter(other.fiftyMoveCounter), zobristHash(other.zobristHash), prevMove(other.prevMove) {
+			fiftyMoveCounter(other.fiftyMoveCounter), zobristHash(other.zobristHash), prevMove(other.prevMove),
+			checkers(other.checkers), checkersComputed(other.checkersComputed) {
 		}
 
 		BoardState& operator=(const BoardState& other) {
@@ -29,6 +30,8 @@ namespace SandalBot {
 			this->fiftyMoveCounter = other.fiftyMoveCounter;
 			this->zobristHash = other.zobristHash;
 			this->prevMove = other.prevMove;
+			this->checkers = other.checkers;
+			this->checkersComputed = other.checkersComputed;
 			return *this;
 		}
 
@@ -39,6 +42,8 @@ namespace SandalBot {
 			this->fiftyMoveCounter = other.fiftyMoveCounter;
 			this->zobristHash = other.zobristHash;
 			this->prevMove = other.prevMove;
+			this->checkers = other.checkers;
+			this->checkersComputed = other.checkersComputed;
 			return *this;
 		}
 
@@ -49,6 +54,10 @@ namespace SandalBot {
 		Piece capturedPiece{};
 		Square enPassantSquare{};
 		CastlingRights cr{}; // Store castling rights in binary form to conserve memory
+
+		// Enemy pieces checking the side to move, computed lazily by Board::checkers
+		Bitboard checkers{};
+		bool checkersComputed{ false };
 	};
 
 }
@@ -2,9 +2,16 @@
 #define BOT_H
 
 #include "Board.h"
+#include "PerfCounters.h"
+#include "Perft.h"
+#include "SearchListener.h"
 #include "Searcher.h"
+#include "TranspositionTable.h"
 
+#include <memory>
+#include <string>
 #include <string_view>
+#include <vector>
 
 namespace SandalBot {
 
@@ -14,26 +21,52 @@ namespace SandalBot {
 	class Bot {
 	public:
 		Bot();
+		Bot(std::shared_ptr<TranspositionTable> table);
 		~Bot();
 
-		void setPosition(std::string_view FEN);
-		void makeMove(std::string movestr);
+		void newGame(bool clearHash = true);
+		void setListener(SearchListener* listener);
+		bool setPosition(std::string_view FEN, const std::vector<std::string>& moves = {});
+		void setSearchLimits(int depth, uint64_t nodes, int mate, const std::vector<std::string>& searchMoves);
+		bool makeMove(std::string movestr);
+		std::string fen() const;
 		std::string generateMove(int moveTimeMs);
+		std::string generateMove(int whiteTimeMs, int blackTimeMs, int whiteIncMs, int blackIncMs, int movesToGo);
 		void go();
+		std::string ponder(int whiteTimeMs, int blackTimeMs, int whiteIncMs, int blackIncMs, int movesToGo, int moveTimeMs);
+		void ponderHit();
 		int eval();
+		void prepareSearch();
 		void stopSearching();
 		uint64_t perft(int depth);
 		void printBoard();
-		int chooseMoveTime(int whiteTimeMs, int blackTimeMs, int whiteIncMs = 0, int blackIncMs = 0);
 		void changeHashSize(int sizeMB);
 		void clearHash();
+		void setLazyEvalMargin(int margin);
+		void setPseudoLegal(bool pseudoLegal);
+		void setPerftHashSize(int sizeMB);
+		void setPerftThreads(int threads);
+		void setPerfCounters(bool enabled);
+		void setSearchStats(Searcher::StatsFormat format);
+		void setMoveOverhead(int overheadMs);
+		void setMultiPV(int lines);
+		bool perfCountersEnabled() const { return perfCounters; }
+		// Nodes searched by the most recent search
+		uint64_t nodes() const { return searcher->nodes(); }
 	private:
-		const int maxMoveTime{ 3000 }; // Maximum move time
-
 		Board* board{ nullptr };
 		Searcher* searcher{ nullptr };
+		Perft* perftRunner{ nullptr };
+		bool perfCounters{ false }; // Whether hardware performance counters are reported
+		SearchListener* listener{ nullptr }; // Receives results of searches and perft, none discards them
+
+		// Position last set by setPosition, so a move list extending it only plays the new moves.
+		// An empty FEN means the board has changed since and must be reloaded
+		std::string positionFEN{};
+		std::vector<std::string> positionMoves{};
 
-		int validateUserMove(MovePoint moves[218], Square from, Square to, Move::Flag flag);
+		Move parseUserMove(const std::string& movestr);
+		std::string reportBestMove();
 	};
 
 }
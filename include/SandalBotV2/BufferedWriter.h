@@ -0,0 +1,36 @@
+#ifndef BUFFEREDWRITER_H
+#define BUFFEREDWRITER_H
+
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <string_view>
+
+namespace SandalBot {
+
+	// BufferedWriter collects output lines and writes them to a stream in a single call per flush,
+	// instead of formatting and flushing every line on its own. Writes are locked, so lines from the
+	// search thread and the command loop are never interleaved
+	class BufferedWriter {
+	public:
+		BufferedWriter(std::ostream& out = std::cout) : out(out) {}
+		BufferedWriter(const BufferedWriter&) = delete;
+		BufferedWriter& operator=(const BufferedWriter&) = delete;
+
+		// Buffers text, written with the next flush
+		void append(std::string_view text);
+		// Writes buffered text followed by text, then flushes the stream
+		void write(std::string_view text);
+		void writeLine(std::string_view line);
+		void flush();
+	private:
+		std::ostream& out;
+		std::mutex mutex;
+		std::string buffer{};
+
+		void flushBuffer();
+	};
+
+}
+
+#endif // !BUFFEREDWRITER_H
@@ -0,0 +1,98 @@
+#ifndef ENGINE_H
+#define ENGINE_H
+
+#include "Bot.h"
+#include "Move.h"
+#include "SearchListener.h"
+#include "SearchThread.h"
+#include "TranspositionTable.h"
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace SandalBot {
+
+	// Limits of an engine search, zero or empty is no limit. A search without a time, depth, node
+	// or mate limit runs until it is stopped
+	struct SearchRequest {
+		int moveTimeMs{};
+		int depth{};
+		uint64_t nodes{};
+		int mate{}; // Search ends once a mate in this many moves is found
+		int multiPV{ 1 }; // Best moves searched, each with its own line
+		std::vector<std::string> searchMoves{}; // Root moves searched in UCI notation
+	};
+
+	// Outcome of an engine search, taken from its last completed iteration
+	struct SearchResult {
+		Move bestMove{}; // Null when the position has no legal move
+		Move ponderMove{}; // Expected reply, null when the principal variation has none
+		int eval{}; // Score of the best move from the side to move
+		int depth{};
+		uint64_t nodes{}; // Nodes searched over every iteration
+		std::vector<RootLine> lines{};
+	};
+
+	struct EngineOptions {
+		int hashSizeMB{ 16 };
+		// Searched instead of a table of the engine's own when set, see Engine::createTable
+		std::shared_ptr<TranspositionTable> sharedTable{};
+	};
+
+	// Engine is the interface for programs embedding SandalBot rather than talking UCI to it. Each
+	// instance has its own position and search state, while the move generation tables are shared by
+	// the whole process and a transposition table may be shared by any number of instances, so many
+	// small engines fit in one process. Searches run on the calling thread, or asynchronously on a
+	// thread of the instance created by its first asynchronous search, which reports the result to a
+	// callback. Methods using the position wait for an asynchronous search to end first, and a
+	// callback must not start a search of its own engine
+	class Engine {
+	public:
+		using Callback = std::function<void(const SearchResult&)>;
+
+		Engine(const EngineOptions& options = {});
+		~Engine();
+		Engine(const Engine&) = delete;
+		Engine& operator=(const Engine&) = delete;
+
+		static std::shared_ptr<TranspositionTable> createTable(int sizeMB);
+
+		bool setPosition(std::string_view fen, const std::vector<std::string>& moves = {});
+		bool makeMove(const std::string& move);
+		std::string fen();
+		void newGame();
+		void setListener(SearchListener* listener);
+		SearchResult search(const SearchRequest& request);
+		void searchAsync(const SearchRequest& request, Callback onComplete);
+		void stop();
+		void wait();
+		bool searching();
+	private:
+		// Keeps the results of the running search, and passes every event on to the host's listener
+		class ResultCollector : public SearchListener {
+		public:
+			SearchListener* listener{ nullptr };
+			SearchResult result{};
+
+			void onIteration(const IterationReport& report) override;
+			void onCurrentMove(int depth, Move move, int moveNumber, uint64_t timeMs) override;
+			void onBestMove(Move move, Move ponder) override;
+			void onPerftMove(Move move, uint64_t nodes) override;
+			void onInfo(std::string_view text) override;
+		};
+
+		bool sharedTable{ false }; // Whether the table is shared, so new games leave it alone
+		Bot bot;
+		ResultCollector collector{};
+		std::unique_ptr<SearchThread> searchThread{};
+
+		SearchResult run(const SearchRequest& request);
+	};
+
+}
+
+#endif // !ENGINE_H
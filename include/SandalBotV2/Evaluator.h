@@ -16,10 +16,26 @@ namespace SandalBot {
 		static constexpr int checkMateScore{ 100000 };
 		static constexpr int drawScore{ 0 };
 		static constexpr int cancelledScore{ 0 };
+		// Default margin the cheap material and position score must clear the window by to exit early
+		static constexpr int defaultLazyMargin{ 400 };
+
+		int lazyMargin{ defaultLazyMargin };
+		// Counters for lazy evaluation, number of evaluations exited early and total evaluations
+		uint64_t lazyExits{};
+		uint64_t lazyProbes{};
+
+		// Terms summed by a full evaluation, which can be evaluated on their own to inspect or time them
+		enum Term {
+			STATIC_PIECES, PAWN_ISLANDS, PASSED_PAWNS, KING_SAFETY, MOBILITY, THREATS, OPEN_FILES, OPEN_DIAGONALS,
+			TERM_NB
+		};
 
 		Evaluator() {};
 
 		int Evaluate(Board* board);
+		int Evaluate(Board* board, int alpha, int beta);
+		int evaluateTerm(Board* board, Term term);
+		void resetStatistics() { lazyExits = 0ULL; lazyProbes = 0ULL; }
 		bool insufficientMaterial();
 		static bool isMateScore(int score);
 		static int movesTilMate(int score);
@@ -62,6 +78,10 @@ namespace SandalBot {
 		static constexpr unsigned char pawnShieldColumnPenalty{ 30 };
 		static constexpr unsigned char pawnShieldUndefendedPenalty{ 30 };
 		static constexpr float kingSafetyCoefficient{ 0.04f };
+		// Bonus per safe square attacked by each piece type
+		static constexpr unsigned char mobilityWeightings[7]{ 0, 0, 4, 3, 2, 1, 0 };
+		static constexpr unsigned char pawnThreatBonus{ 40 };
+		static constexpr unsigned char hangingPieceBonus{ 15 };
 
 		static constexpr unsigned char openFileBonus{ 20 };
 		static constexpr unsigned char openFileNearKingBonus{ 40 };
@@ -72,6 +92,7 @@ namespace SandalBot {
 		float endGameWeight{};
 
 		void calculateEndgameWeight();
+		int fullEvaluation();
 
 		template <Color Us>
 		int evaluateSide();
@@ -90,7 +111,10 @@ namespace SandalBot {
 		int pawnIslandEvaluation();
 		template <Color Us>
 		int kingAttackZone();
-		int incrementAttackZoneEval(Bitboard attackZone, Bitboard moves, PieceType piece);
+		template <Color Us>
+		int mobilityEvaluation();
+		template <Color Us>
+		int threatEvaluation();
 
 		int kingDist(int currentEvaluation);
 
@@ -102,11 +126,6 @@ namespace SandalBot {
 
 		bool openDiagFileNearKing(Bitboard mask, Square kingSquare);
 
-		template <Color Us, PieceType Type>
-		int evalMoves(Bitboard attackZone);
-		template <Color Us>
-		int evalPawnMoves(Bitboard attackZone);
-
 		bool insufficientMateMaterial(int material);
 	};
 
@@ -2,15 +2,24 @@
 #define IUCI_H
 
 #include <array>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <iostream>
+#include <mutex>
 #include <string>
 #include <string_view>
-#include <thread>
 #include <vector>
 
+#include "Bench.h"
 #include "Bot.h"
+#include "BufferedWriter.h"
 #include "FEN.h"
 #include "OptionHandler.h"
+#include "SearchThread.h"
 #include "StringUtil.h"
+#include "UCIListener.h"
 
 namespace SandalBot {
 
@@ -23,12 +32,15 @@ namespace SandalBot {
 	public:
 		IUCI();
 		~IUCI();
+		void loop(std::istream& in);
 		void processCommand(std::string command);
 		void newGame();
 		void stop();
+		void ponderHit();
 		void quit();
 		void UCIok();
 		void eval();
+		void bench(std::string command);
 		void OnMoveChosen(std::string move);
 		void processGoCommand(std::string command);
 		void processPositionCommand(std::string command);
@@ -40,12 +52,25 @@ namespace SandalBot {
 		std::string getLabelledValue(std::string text, std::string label, const std::array<T, N> allLabels);
 		void logInfo(std::string text);
 	private:
+		BufferedWriter writer{}; // Output to the GUI, shared by responses and search results
+		UCIListener listener{ writer };
 		Bot* bot{ nullptr };
 		OptionHandler* optionHandler{ nullptr };
-		std::thread goThread{}; // Thread for asynchronous searching
+		SearchThread searchThread{}; // Runs go commands while commands are still read
+		std::atomic<bool> infiniteSearch{ false }; // Whether the running search only ends when stopped
+		std::atomic<bool> pondering{ false }; // Whether the running search waits for ponderhit
+		std::atomic<bool> stoppable{ false }; // Whether the posted job is a search, rather than bench or perft
+		bool quitting{ false }; // Set by quit to end the command loop
+
+		// Commands read by the input thread and waiting to be processed in order
+		std::mutex inputMutex;
+		std::condition_variable inputReady;
+		std::deque<std::string> inputQueue{};
+		bool processing{ false }; // Whether a command taken from the queue is being processed
 		// Label vectors contain key words for specific commands to aid parsing commands
 		const std::array<std::string_view, 3> positionLabels { "position"sv, "fen"sv, "moves"sv };
-		const std::array<std::string_view, 8> goLabels { "go"sv, "movetime"sv, "wtime"sv, "btime"sv, "winc"sv, "binc"sv, "movestogo"sv, "perft"sv };
+		const std::array<std::string_view, 14> goLabels { "go"sv, "movetime"sv, "wtime"sv, "btime"sv, "winc"sv, "binc"sv, "movestogo"sv, "perft"sv,
+			"ponder"sv, "infinite"sv, "depth"sv, "nodes"sv, "mate"sv, "searchmoves"sv };
 		const std::array<std::string_view, 2> optionLabels { "name"sv, "value"sv };
 
 		const std::string_view logPath { "logs.txt"sv }; // filePath for log file
@@ -55,6 +80,9 @@ namespace SandalBot {
 
 		void beginningMessage();
 		void emptyLogs();
+		bool awaitSearch();
+		void post(std::function<void()> job);
+		void readInput(std::istream& in);
 	};
 
 }
@@ -2,13 +2,15 @@
 #define INIT_H
 
 #include "Bitboards.h"
-#include "ZobristHash.h"
+
+#include <mutex>
 
 namespace SandalBot {
 
+    // Initialises the read-only tables shared by every board, only the first call has any effect
     inline void initGlobals() {
-        ZobristHash::initHashes();
-        initBitboards();
+        static std::once_flag initialised;
+        std::call_once(initialised, initBitboards);
     }
 
 }
@@ -0,0 +1,134 @@
+#ifndef KOGGESTONE_H
+#define KOGGESTONE_H
+
+#include "Bitboards.h"
+#include "Types.h"
+
+#if defined(__AVX2__)
+	#include <immintrin.h>
+#endif
+
+// KoggeStone computes the union of sliding attacks of a whole set of pieces at once using
+// parallel prefix occluded fills (https://www.chessprogramming.org/Kogge-Stone_Algorithm).
+// Unlike magic lookups the cost does not depend on the number of sliders, but the individual
+// attacks of each piece are lost, so magics are still used wherever moves are emitted
+namespace SandalBot::KoggeStone {
+
+	// Shifts a bitboard n steps in a direction without masking wrapped bits
+	template <Direction D>
+	constexpr Bitboard rawShift(Bitboard bitboard, int n) {
+		return int(D) > 0 ? bitboard << (int(D) * n) : bitboard >> (-int(D) * n);
+	}
+
+	// Mask of squares a slider may enter when moving in a direction, prevents wrapping between columns
+	template <Direction D>
+	constexpr Bitboard wrapMask() {
+		return (D == EAST || D == NORTH_EAST || D == SOUTH_EAST) ? ~columnAMask
+			: (D == WEST || D == NORTH_WEST || D == SOUTH_WEST) ? ~columnHMask
+			: ~0ULL;
+	}
+
+	// Fills each slider in direction D until (and excluding) the first occupied square
+	template <Direction D>
+	constexpr Bitboard occludedFill(Bitboard sliders, Bitboard empty) {
+		empty &= wrapMask<D>();
+		sliders |= empty & rawShift<D>(sliders, 1);
+		empty &= rawShift<D>(empty, 1);
+		sliders |= empty & rawShift<D>(sliders, 2);
+		empty &= rawShift<D>(empty, 2);
+		sliders |= empty & rawShift<D>(sliders, 4);
+		return sliders;
+	}
+
+	// Returns all squares attacked by sliders in direction D, including the first blocker
+	template <Direction D>
+	constexpr Bitboard slidingAttacks(Bitboard sliders, Bitboard empty) {
+		return shift<D>(occludedFill<D>(sliders, empty));
+	}
+
+	// Union of the orthogonal attacks of a set of sliders
+	constexpr Bitboard orthogonalAttacks(Bitboard sliders, Bitboard empty) {
+		return slidingAttacks<NORTH>(sliders, empty) | slidingAttacks<SOUTH>(sliders, empty)
+			| slidingAttacks<EAST>(sliders, empty) | slidingAttacks<WEST>(sliders, empty);
+	}
+
+	// Union of the diagonal attacks of a set of sliders
+	constexpr Bitboard diagonalAttacks(Bitboard sliders, Bitboard empty) {
+		return slidingAttacks<NORTH_EAST>(sliders, empty) | slidingAttacks<NORTH_WEST>(sliders, empty)
+			| slidingAttacks<SOUTH_EAST>(sliders, empty) | slidingAttacks<SOUTH_WEST>(sliders, empty);
+	}
+
+#if defined(__AVX2__)
+	// AVX2 variant which fills four directions at once, one direction per 64 bit lane. Lanes
+	// shifting towards lower squares use a right shift, the other lanes a left shift. AVX2
+	// variable shifts produce zero for counts above 63, so each lane only takes one of the shifts
+	namespace Detail {
+		// Fills sliders in the four directions with the given per lane shift counts and wrap masks
+		inline Bitboard fourDirectionAttacks(Bitboard sliders, Bitboard empty,
+			__m256i leftShift, __m256i rightShift, __m256i wrap) {
+			__m256i gen = _mm256_set1_epi64x(static_cast<long long>(sliders));
+			__m256i pro = _mm256_and_si256(_mm256_set1_epi64x(static_cast<long long>(empty)), wrap);
+
+			auto shiftLanes = [](__m256i value, __m256i left, __m256i right) {
+				return _mm256_or_si256(_mm256_sllv_epi64(value, left), _mm256_srlv_epi64(value, right));
+			};
+
+			// Steps of one, two and four squares
+			gen = _mm256_or_si256(gen, _mm256_and_si256(pro, shiftLanes(gen, leftShift, rightShift)));
+			pro = _mm256_and_si256(pro, shiftLanes(pro, leftShift, rightShift));
+			__m256i left2 = _mm256_add_epi64(leftShift, leftShift);
+			__m256i right2 = _mm256_add_epi64(rightShift, rightShift);
+			gen = _mm256_or_si256(gen, _mm256_and_si256(pro, shiftLanes(gen, left2, right2)));
+			pro = _mm256_and_si256(pro, shiftLanes(pro, left2, right2));
+			__m256i left4 = _mm256_add_epi64(left2, left2);
+			__m256i right4 = _mm256_add_epi64(right2, right2);
+			gen = _mm256_or_si256(gen, _mm256_and_si256(pro, shiftLanes(gen, left4, right4)));
+			// Final step onto the blocker, masked against wrapping
+			gen = _mm256_and_si256(shiftLanes(gen, leftShift, rightShift), wrap);
+
+			// Reduce the four lanes to their union
+			__m128i half = _mm_or_si128(_mm256_castsi256_si128(gen), _mm256_extracti128_si256(gen, 1));
+			half = _mm_or_si128(half, _mm_unpackhi_epi64(half, half));
+			return static_cast<Bitboard>(_mm_cvtsi128_si64(half));
+		}
+	}
+
+	// Lanes: NORTH, SOUTH, EAST, WEST. A count of 64 disables the shift for a lane
+	inline Bitboard orthogonalAttacksAVX2(Bitboard sliders, Bitboard empty) {
+		const __m256i leftShift = _mm256_setr_epi64x(64, 8, 1, 64);
+		const __m256i rightShift = _mm256_setr_epi64x(8, 64, 64, 1);
+		const __m256i wrap = _mm256_setr_epi64x(-1LL, -1LL,
+			static_cast<long long>(~columnAMask), static_cast<long long>(~columnHMask));
+		return Detail::fourDirectionAttacks(sliders, empty, leftShift, rightShift, wrap);
+	}
+
+	// Lanes: NORTH_EAST, NORTH_WEST, SOUTH_EAST, SOUTH_WEST
+	inline Bitboard diagonalAttacksAVX2(Bitboard sliders, Bitboard empty) {
+		const __m256i leftShift = _mm256_setr_epi64x(64, 64, 9, 7);
+		const __m256i rightShift = _mm256_setr_epi64x(7, 9, 64, 64);
+		const __m256i wrap = _mm256_setr_epi64x(static_cast<long long>(~columnAMask), static_cast<long long>(~columnHMask),
+			static_cast<long long>(~columnAMask), static_cast<long long>(~columnHMask));
+		return Detail::fourDirectionAttacks(sliders, empty, leftShift, rightShift, wrap);
+	}
+#endif
+
+	// Preferred implementation for the target the engine is compiled for
+	inline Bitboard orthogonalUnion(Bitboard sliders, Bitboard empty) {
+#if defined(__AVX2__)
+		return orthogonalAttacksAVX2(sliders, empty);
+#else
+		return orthogonalAttacks(sliders, empty);
+#endif
+	}
+
+	inline Bitboard diagonalUnion(Bitboard sliders, Bitboard empty) {
+#if defined(__AVX2__)
+		return diagonalAttacksAVX2(sliders, empty);
+#else
+		return diagonalAttacks(sliders, empty);
+#endif
+	}
+
+}
+
+#endif // !KOGGESTONE_H
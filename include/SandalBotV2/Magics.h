@@ -3,13 +3,15 @@
 
 #include "Types.h"
 
-#include <memory>
-#include <vector>
+#include <array>
+#include <cstddef>
+#include <immintrin.h>
 
 namespace SandalBot {
 
 	// PrecomputedMagics stores hashtable to orthogonal and diagonal moves via indexing by blocker bitboards.
-	// Hashtables are indexed by: (blockerboard * magic number) >> right shift number
+	// Hashtables are indexed by: (blockerboard * magic number) >> right shift number, or by PEXT of the
+	// blockerboard on CPUs with fast BMI2
 	namespace BitMagics {
 		#pragma pack(push, 1)
 		struct MagicInfo {
@@ -26,24 +28,68 @@ namespace SandalBot {
 		constexpr int maxOrthogonalIndexes[SQUARES_NB]{ 8190, 4091, 4093, 4094, 4094, 4094, 4094, 8188, 4095, 2045, 2046, 2046, 2046, 2045, 2046, 4094, 4024, 2046, 2046, 2046, 2046, 2046, 2046, 4091, 4094, 2043, 2046, 2045, 2046, 2046, 2046, 4094, 4094, 2046, 2046, 2046, 2045, 2044, 2045, 4094, 4092, 2046, 2045, 2044, 2046, 2046, 2046, 4094, 4091, 2047, 2046, 2045, 2044, 2046, 2046, 4094, 8190, 4094, 4094, 4095, 4095, 4091, 4094, 8190 };
 		constexpr int maxDiagonalIndexes[SQUARES_NB]{ 125, 59, 62, 62, 63, 61, 62, 126, 60, 62, 60, 63, 61, 62, 62, 61, 61, 61, 254, 254, 253, 254, 61, 63, 60, 61, 255, 1016, 1022, 253, 62, 61, 62, 57, 254, 1020, 1019, 255, 61, 62, 62, 62, 255, 247, 254, 253, 63, 61, 62, 62, 62, 58, 60, 61, 62, 59, 127, 62, 63, 61, 63, 62, 60, 117 };
 
-		// Move Hashtables
-		extern std::unique_ptr<Bitboard[]> orthogonalMoves[SQUARES_NB];
-		extern std::unique_ptr<Bitboard[]> diagonalMoves[SQUARES_NB];
+		// Scheme used to index the sliding attack table, selected once at startup
+		enum class Backend : uint8_t {
+			MAGIC, // (blockers * magic number) >> right shift number
+			PEXT // Parallel bit extract of the blockers under the mask (BMI2)
+		};
+
+		constexpr int BACKEND_NB{ 2 };
+
+		// Lookup information for a single square and sliding direction
+		struct SlidingEntry {
+			Bitboard mask{}; // Squares which may block the slider, excluding edges
+			uint64_t magic{};
+			uint8_t rightShift{};
+			uint32_t offsets[BACKEND_NB]{}; // Start of the square's moves in the attack table for each backend
+		};
 
+		// Number of moves stored by each backend for both sliding directions
+		constexpr std::size_t orthogonalMagicSize = [] {
+			std::size_t size = 0;
+			for (int index : maxOrthogonalIndexes) size += index + 1;
+			return size;
+		}();
+		constexpr std::size_t diagonalMagicSize = [] {
+			std::size_t size = 0;
+			for (int index : maxDiagonalIndexes) size += index + 1;
+			return size;
+		}();
+		constexpr std::size_t orthogonalPextSize{ 102400 }; // Sum of 2^(number of blocker squares) over all squares
+		constexpr std::size_t diagonalPextSize{ 5248 };
+		constexpr std::size_t attackTableSize{ orthogonalMagicSize + diagonalMagicSize + orthogonalPextSize + diagonalPextSize };
 
-		void initMagics();
-		void addOrthogonalMoves(Square square, std::vector<Bitboard>& blockers, std::vector<Bitboard>& movementBoards);
-		void addDiagonalMoves(Square square, std::vector<Bitboard>& blockers, std::vector<Bitboard>& movementBoards);
+		extern Backend backend;
 
-		inline std::size_t getOrthIndex(const Bitboard blockers, const Square square) { return (blockers * orthogonalMagics[square].magic) >> orthogonalMagics[square].rightShift; }
-		inline std::size_t getDiagIndex(const Bitboard blockers, const Square square) { return (blockers * diagonalMagics[square].magic) >> diagonalMagics[square].rightShift; }
+		// Single contiguous, compile time generated table holding the moves of both backends for every square
+		extern const std::array<Bitboard, attackTableSize> attackTable;
+		extern const std::array<SlidingEntry, SQUARES_NB> orthogonalEntries;
+		extern const std::array<SlidingEntry, SQUARES_NB> diagonalEntries;
+
+		bool pextSupported();
+
+		// PEXT is only executed when pextSupported() returned true, so it may be compiled
+		// for BMI2 even when the rest of the engine is not
+#if defined(__BMI2__)
+		inline uint64_t pext(const Bitboard blockers, const Bitboard mask) { return _pext_u64(blockers, mask); }
+#else
+		__attribute__((target("bmi2"))) inline uint64_t pext(const Bitboard blockers, const Bitboard mask) { return _pext_u64(blockers, mask); }
+#endif
+
+		// Blockers outside of the square's mask are ignored, so the full board may be passed
+		inline Bitboard getMovement(const SlidingEntry& entry, const Bitboard blockers) {
+			if (backend == Backend::PEXT) {
+				return attackTable[entry.offsets[int(Backend::PEXT)] + pext(blockers, entry.mask)];
+			}
+			return attackTable[entry.offsets[int(Backend::MAGIC)] + (((blockers & entry.mask) * entry.magic) >> entry.rightShift)];
+		}
 
 		inline Bitboard getOrthogonalMovement(const Square square, const Bitboard blockers) {
-			return orthogonalMoves[square].get()[getOrthIndex(blockers, square)];
+			return getMovement(orthogonalEntries[square], blockers);
 		}
 		
 		inline Bitboard getDiagonalMovement(const Square square, const Bitboard blockers) {
-			return diagonalMoves[square].get()[getDiagIndex(blockers, square)];
+			return getMovement(diagonalEntries[square], blockers);
 		}
 	};
 
@@ -1,6 +1,7 @@
 #ifndef MOVEGEN_H
 #define MOVEGEN_H
 
+#include "AttackInfo.h"
 #include "Bitboards.h"
 #include "Board.h"
 #include "CoordHelper.h"
@@ -11,9 +12,20 @@ namespace SandalBot {
 
 	struct MovePoint;
 
+	// Slices of the moves which MoveGen can generate. All slices except PSEUDO_LEGAL only contain legal moves
+	enum GenType {
+		CAPTURES, // Captures, including capturing promotions and en passant
+		QUIETS, // Non captures, including push promotions and castling
+		QUIET_CHECKS, // Quiet moves giving direct or discovered check, excluding promotions and castling
+		EVASIONS, // King moves, blocks and captures of the checker. Requires the side to move to be in check
+		LEGAL, // All legal moves
+		// All moves ignoring pins and king safety, each must be checked with Board::isLegal before being made.
+		// Skips computing attack and pin data of the position, which is wasted at nodes cutting off early
+		PSEUDO_LEGAL
+	};
+
 	// MoveGen class generates all possible legalmoves in a given position
 	class MoveGen {
-		friend class MoveOrderer;
 		friend class Searcher;
 	public:
 		static constexpr int maxMoves{ 218 };
@@ -29,30 +41,38 @@ namespace SandalBot {
 				throw std::invalid_argument("board cannot be nullptr");
 		}
 
-		int generate(MovePoint moves[], bool capturesOnly = false);
+		template <GenType Gen = LEGAL>
+		int generate(MovePoint moves[]);
 
 	private:
 		Board* board = nullptr;
 
 		uint64_t currentMoves{};
 		bool doubleCheck{};
-		bool generateCaptures{};
 
-		// Utility bitboards
+		// Check and pin data filtering the generated moves, copied from the position's AttackInfo.
+		// Pseudo legal generation only computes the check mask, leaving pins and king safety empty
+		Bitboard checkMask{};
+		Bitboard pinned{};
 		Bitboard opponentAttacks{};
-		Bitboard checkBB{};
-		Bitboard checkRayBB{};
 
+		// Check squares and discovered check candidates of the position, only computed for QUIET_CHECKS
+		const AttackInfo* checkInfo{ nullptr };
+
+		template <GenType Gen>
 		void initVariables();
+		Bitboard quietCheckTargets(PieceType type, Square from, Square enemyKing) const;
 
+		template <Color Us, GenType Gen>
+		int generateAllMoves(MovePoint moves[]);
 		template <Color Us>
-		int generateAllMoves(MovePoint moves[], bool capturesOnly = false);
-		template <Color Us, PieceType Type>
-		void generateMoves(MovePoint moves[], bool capturesOnly);
-		template <Color Us>
-		void generatePawnMoves(MovePoint moves[], bool capturesOnly);
-		template <Color Us>
-		void generateKingMoves(MovePoint moves[], bool capturesOnly);
+		int generateEvasions(MovePoint moves[]);
+		template <Color Us, PieceType Type, GenType Gen>
+		void generateMoves(MovePoint moves[], Bitboard targets);
+		template <Color Us, GenType Gen>
+		void generatePawnMoves(MovePoint moves[], Bitboard targets);
+		template <Color Us, GenType Gen>
+		void generateKingMoves(MovePoint moves[]);
 
 		template <Color Us>
 		void enPassantMoves(MovePoint moves[], Square from, Square to, bool isPinned);
@@ -64,15 +84,6 @@ namespace SandalBot {
 		template <Color Us>
 		void castlingMoves(MovePoint moves[], Square from);
 
-		template <Color Us>
-		Bitboard generatePawnAttackData();
-		template <Color Us, PieceType Type>
-		Bitboard generateAttackData();
-		template <Color Us>
-		void generateAllAttackData();
-		template <Color Us>
-		void generateCheckData();
-
 		void addMove(MovePoint moves[], Square from, Square to, Move::Flag flag = Move::Flag::NO_FLAG) {
 			moves[currentMoves++].move = std::move(Move(from, to, flag));
 		}
@@ -4,6 +4,7 @@
 #include "Move.h"
 
 #include <string>
+#include <vector>
 
 namespace SandalBot {
 	
@@ -20,6 +21,9 @@ namespace SandalBot {
 		void add(Move move);
 		void reset();
 		std::string str();
+		size_t length() const { return size; }
+		Move operator[](size_t index) const { return line[index]; }
+		std::vector<Move> moves() const { return std::vector<Move>(line, line + size); }
 	private:
 		Move* line{ nullptr }; // Array of moves
 		size_t capacity{ 0 };
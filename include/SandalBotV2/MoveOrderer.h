@@ -10,12 +10,11 @@ namespace SandalBot {
 
 	using PointValue = int16_t;
 
-	class MoveGen;
-
 	// Struct holds a move and corresponding heuristic value
 	struct MovePoint {
 		PointValue value{};
 		Move move{};
+		bool givesCheck{}; // Set by search before ordering, so the check test is made once per move
 	};
 
 	// MoveOrderer heuristically orders and array of moves from best to worst.
@@ -25,7 +24,7 @@ namespace SandalBot {
 	public:
 		MoveOrderer() {};
 
-		void order(Board* board, MoveGen* generator, MovePoint moves[], Move bestMove, int numMoves, int depth, bool qSearch = false);
+		void order(Board* board, MovePoint moves[], Move bestMove, int numMoves, int depth, bool qSearch = false);
 		void addKiller(int depth, Move move);
 
 		static void quickSort(MovePoint moves[], int start, int end);
@@ -60,6 +59,7 @@ namespace SandalBot {
 		static constexpr PointValue rookPromotionValue{ 400 };
 		static constexpr PointValue bishopPromotionValue{ 300 };
 		static constexpr PointValue knightPromotionValue{ 300 };
+		static constexpr PointValue checkValue{ 200 };
 
 		Killer killerMoves[32]; // Array of killer moves where index is depth of killer move
 	};
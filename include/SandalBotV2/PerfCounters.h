@@ -0,0 +1,50 @@
+#ifndef PERFCOUNTERS_H
+#define PERFCOUNTERS_H
+
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <string_view>
+
+namespace SandalBot {
+
+	// PerfCounters reads hardware performance counters of the engine through Linux perf_event_open,
+	// to show whether a change affected cache behaviour or branch prediction rather than only NPS.
+	// Counters are opened on start and inherited by threads created afterwards, so threads spawned
+	// by perft and bench are included once they have been joined. Events the CPU or kernel
+	// does not expose are reported as unavailable, and on other platforms nothing is counted
+	class PerfCounters {
+	public:
+		enum Event {
+			CYCLES, INSTRUCTIONS, L1D_MISSES, LLC_MISSES, BRANCH_MISSES, DTLB_MISSES,
+			EVENT_NB
+		};
+
+		PerfCounters() = default;
+		~PerfCounters();
+		PerfCounters(const PerfCounters&) = delete;
+		PerfCounters& operator=(const PerfCounters&) = delete;
+
+		bool start();
+		void stop();
+		bool available(Event event) const { return counted[event]; }
+		uint64_t count(Event event) const { return counts[event]; }
+		// Writes every event per node on one line, e.g. "<prefix>perf cycles/node 812.4 ..."
+		void report(std::ostream& out, uint64_t nodes, std::string_view prefix = "") const;
+		const std::string& error() const { return lastError; }
+	private:
+		static constexpr std::string_view eventNames[EVENT_NB]{
+			"cycles", "instructions", "l1d-misses", "llc-misses", "branch-misses", "dtlb-misses"
+		};
+
+		int fds[EVENT_NB]{ -1, -1, -1, -1, -1, -1 };
+		bool counted[EVENT_NB]{};
+		uint64_t counts[EVENT_NB]{};
+		std::string lastError{};
+
+		void close();
+	};
+
+}
+
+#endif // !PERFCOUNTERS_H
@@ -0,0 +1,79 @@
+#ifndef PERFT_H
+#define PERFT_H
+
+#include "Board.h"
+#include "MoveGen.h"
+#include "SearchListener.h"
+#include "Types.h"
+
+#include <atomic>
+#include <memory>
+
+namespace SandalBot {
+
+	// PerftTable stores node counts of subtrees keyed on the zobrist hash and remaining depth, and is
+	// shared between perft threads. The key is stored xored with the data, so an entry torn by two
+	// threads writing at once fails the key check instead of returning a wrong count
+	class PerftTable {
+	public:
+		void resize(std::size_t sizeMB);
+		bool empty() const { return size == 0; }
+		bool probe(HashKey hash, int depth, uint64_t& nodes) const;
+		void store(HashKey hash, int depth, uint64_t nodes);
+	private:
+		// Node counts occupy the low 56 bits of the data and the remaining depth the high 8 bits
+		struct Entry {
+			std::atomic<uint64_t> key{};
+			std::atomic<uint64_t> data{};
+		};
+
+		static constexpr int depthShift{ 56 };
+		static constexpr uint64_t nodesMask{ (1ULL << depthShift) - 1 };
+
+		std::unique_ptr<Entry[]> entries{};
+		std::size_t size{ 0 };
+	};
+
+	// Perft counts the leaf nodes of the legal move tree to a fixed depth, used to validate move
+	// generation against known counts. Moves at the last ply are counted without being made (bulk
+	// counting), and counts of transposed subtrees are reused from a hash table. Deep runs are split
+	// into second ply subtrees which are shared out between threads, each with its own board copy
+	class Perft {
+	public:
+		static constexpr int defaultHashSizeMB{ 16 };
+
+		Perft() = default;
+		Perft(Board* board);
+
+		uint64_t run(int depth);
+		uint64_t divide(int depth, SearchListener& listener);
+		void setHashSize(int sizeMB);
+		void setPseudoLegal(bool pseudoLegal) { this->pseudoLegal = pseudoLegal; }
+		// Sets the number of threads, zero uses every hardware thread
+		void setThreads(int threads) { this->threads = threads; }
+	private:
+		// Minimum depth split between threads, shallower runs finish before threads start
+		static constexpr int minParallelDepth{ 4 };
+
+		Board* board{ nullptr };
+		MoveGen moveGenerator{};
+		bool pseudoLegal{ false };
+		int threads{ 0 };
+
+		// Allocated on the first run and kept between runs, since counts only depend on the position
+		std::shared_ptr<PerftTable> table{ std::make_shared<PerftTable>() };
+		std::size_t hashSizeMB{ defaultHashSizeMB };
+
+		int threadCount() const;
+		uint64_t subtree(int depth);
+		void divideParallel(int depth, const MovePoint rootMoves[], int numRootMoves, uint64_t rootNodes[]);
+
+		template <bool PseudoLegal>
+		uint64_t search(int depth);
+		template <bool PseudoLegal>
+		int generate(MovePoint moves[]);
+	};
+
+}
+
+#endif // !PERFT_H
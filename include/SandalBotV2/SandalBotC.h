@@ -0,0 +1,73 @@
+#ifndef SANDALBOTC_H
+#define SANDALBOTC_H
+
+#include <stdint.h>
+
+/*
+ * C interface to the embeddable engine, for hosts loading SandalBot through a foreign function
+ * interface. Engines and tables are opaque handles. Functions never throw, errors, including a null
+ * engine handle, are returned as SANDALBOT_ERROR or a null handle. Each engine may be used from one
+ * thread at a time, while different engines, and engines sharing a table, may search at once on
+ * different threads.
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+enum {
+	SANDALBOT_OK = 0,
+	SANDALBOT_ERROR = -1
+};
+
+typedef struct sandalbot_engine sandalbot_engine;
+typedef struct sandalbot_table sandalbot_table;
+
+/* Limits of a search, zero is no limit. A search without a time, depth, node or mate limit runs until stopped */
+typedef struct sandalbot_limits {
+	int move_time_ms;
+	int depth;
+	uint64_t nodes;
+	int mate;
+	int multi_pv; /* Best moves searched, zero searches one */
+} sandalbot_limits;
+
+/* Result of a search. Moves are in UCI notation, empty when there is no move */
+typedef struct sandalbot_result {
+	char best_move[6];
+	char ponder_move[6];
+	int score_cp; /* Centipawns from the side to move, zero for mate scores */
+	int mate; /* Moves until mate, negative when the side to move is mated, zero without a mate */
+	int depth;
+	uint64_t nodes;
+} sandalbot_result;
+
+/* Called on the engine's search thread when an asynchronous search ends */
+typedef void (*sandalbot_callback)(const sandalbot_result* result, void* user_data);
+
+/* Tables are reference counted, a table released while engines use it lives until they are destroyed */
+sandalbot_table* sandalbot_table_create(int size_mb);
+void sandalbot_table_release(sandalbot_table* table);
+
+/* Creates an engine at the start position with a table of its own, or searching the shared table if one is given */
+sandalbot_engine* sandalbot_engine_create(int hash_size_mb, sandalbot_table* shared_table);
+/* Stops any search and waits for its callback before destroying the engine, a null engine is ignored */
+void sandalbot_engine_destroy(sandalbot_engine* engine);
+int sandalbot_engine_new_game(sandalbot_engine* engine);
+
+/* Sets a position from a FEN string, or the start position for null or "startpos", followed by space separated moves */
+int sandalbot_engine_set_position(sandalbot_engine* engine, const char* fen, const char* moves);
+int sandalbot_engine_make_move(sandalbot_engine* engine, const char* move);
+
+int sandalbot_engine_search(sandalbot_engine* engine, const sandalbot_limits* limits, sandalbot_result* result);
+int sandalbot_engine_search_async(sandalbot_engine* engine, const sandalbot_limits* limits,
+	sandalbot_callback callback, void* user_data);
+/* May be called from any thread */
+int sandalbot_engine_stop(sandalbot_engine* engine);
+int sandalbot_engine_wait(sandalbot_engine* engine);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* !SANDALBOTC_H */
@@ -0,0 +1,52 @@
+#ifndef SEARCHLISTENER_H
+#define SEARCHLISTENER_H
+
+#include "Move.h"
+
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace SandalBot {
+
+	// Best move, score and principal variation of one of the best root moves of an iteration
+	struct RootLine {
+		Move move{};
+		int eval{};
+		std::vector<Move> pv{};
+	};
+
+	// Results of a completed iterative deepening iteration
+	struct IterationReport {
+		int depth{};
+		int seldepth{};
+		uint64_t nodes{};
+		uint64_t nps{};
+		uint64_t timeMs{};
+		int hashfull{}; // Permille of transposition table slots in use
+		std::vector<RootLine> lines{}; // Best first, more than one with MultiPV
+	};
+
+	// SearchListener receives the results of searches and perft as they are produced, so they can be
+	// consumed without parsing text. Events arrive on the thread running the search, and every event
+	// is ignored unless overridden
+	class SearchListener {
+	public:
+		virtual ~SearchListener() = default;
+
+		// An iteration completed
+		virtual void onIteration([[maybe_unused]] const IterationReport& report) {}
+		// A root move is about to be searched, numbered from one, with the time since search began
+		virtual void onCurrentMove([[maybe_unused]] int depth, [[maybe_unused]] Move move,
+			[[maybe_unused]] int moveNumber, [[maybe_unused]] uint64_t timeMs) {}
+		// Search ended. The ponder move is null when the principal variation has no reply
+		virtual void onBestMove([[maybe_unused]] Move move, [[maybe_unused]] Move ponder) {}
+		// Nodes below a root move of perft divide, reported in generation order
+		virtual void onPerftMove([[maybe_unused]] Move move, [[maybe_unused]] uint64_t nodes) {}
+		// Diagnostic text, such as time allotment and counters, one or more lines
+		virtual void onInfo([[maybe_unused]] std::string_view text) {}
+	};
+
+}
+
+#endif // !SEARCHLISTENER_H
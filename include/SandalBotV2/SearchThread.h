@@ -0,0 +1,37 @@
+#ifndef SEARCHTHREAD_H
+#define SEARCHTHREAD_H
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace SandalBot {
+
+	// SearchThread is a long lived thread which runs searches posted by the UCI interface, so the
+	// interface keeps reading commands such as stop while a search runs. Between searches the thread
+	// parks on a condition variable instead of being joined, so no thread is created or destroyed per
+	// move and the thread keeps running on a core whose caches hold the searcher's tables
+	class SearchThread {
+	public:
+		SearchThread();
+		~SearchThread();
+		SearchThread(const SearchThread&) = delete;
+		SearchThread& operator=(const SearchThread&) = delete;
+
+		void start(std::function<void()> job);
+		void wait();
+		bool searching();
+	private:
+		std::mutex mutex;
+		std::condition_variable jobChanged; // Notified when a job is posted, finishes, or the thread exits
+		std::function<void()> job{}; // Job being run, empty while parked
+		bool exiting{ false };
+		std::thread thread; // Started last, once the members it reads are initialised
+
+		void idleLoop();
+	};
+
+}
+
+#endif // !SEARCHTHREAD_H
@@ -6,14 +6,20 @@
 #include "MoveGen.h"
 #include "MoveLine.h"
 #include "MoveOrderer.h"
+#include "SearchListener.h"
+#include "TimeManager.h"
 #include "TranspositionTable.h"
 #include "Types.h"
 
+#include <algorithm>
 #include <atomic>
 #include <chrono>
 #include <condition_variable>
 #include <limits>
+#include <memory>
 #include <mutex>
+#include <string>
+#include <vector>
 
 namespace SandalBot {
 
@@ -22,6 +28,18 @@ namespace SandalBot {
 	// searching.
 	class Searcher {
 	public:
+		// Output of search statistics after each iteration, used to tune move ordering and pruning
+		enum class StatsFormat { OFF, INFO, JSON };
+
+		// Limits of a search besides time, from the go command. Zero or empty is no limit, and a
+		// search with a depth, node or mate limit ends by itself instead of waiting to be stopped
+		struct SearchLimits {
+			int depth{}; // Deepest iteration searched
+			uint64_t nodes{}; // Nodes searched before the search is cancelled
+			int mate{}; // Search ends once a mate in this many moves is found
+			std::vector<Move> searchMoves{}; // Root moves searched, all when empty
+		};
+
 		Evaluator evaluator{};
 		MoveGen moveGenerator{};
 		MoveOrderer orderer{};
@@ -29,13 +47,38 @@ namespace SandalBot {
 
 		Searcher() {};
 		Searcher(Board* board);
+		Searcher(Board* board, std::shared_ptr<TranspositionTable> table);
 		~Searcher() {}
 		void startSearch(bool isTimed, int moveTimeMs = 0);
+		void startClockSearch(int timeMs, int incMs, int movesToGo);
+		void startPonderSearch(int timeMs, int incMs, int movesToGo, int moveTimeMs);
+		void ponderHit();
+		void prepareSearch();
+		void searchToDepth(int depth);
 		void endSearch();
 		int eval();
-		uint64_t perft(int depth);
 		void clearHash();
 		void changeHashSize(int sizeMB);
+		void setLazyEvalMargin(int margin) { evaluator.lazyMargin = margin; }
+		void setPseudoLegal(bool pseudoLegal) { this->pseudoLegal = pseudoLegal; }
+		void setReportIterations(bool report) { reportIterations = report; }
+		// Sets the listener receiving search results, none discards them
+		void setListener(SearchListener* listener) { this->listener = listener; }
+		void setPerfCounters(bool enabled) { perfCounters = enabled; }
+		void setStatsFormat(StatsFormat format) { statsFormat = format; }
+		void setMoveOverhead(int overheadMs) { timeManager.setMoveOverhead(overheadMs); }
+		// Limits the number of nodes of each search, zero removes the limit
+		void setNodeLimit(uint64_t nodes) { nodeLimit = nodes == 0ULL ? std::numeric_limits<uint64_t>::max() : nodes; }
+		void setLimits(const SearchLimits& limits);
+		// Sets the number of best root moves searched and reported each iteration
+		void setMultiPV(int lines) { multiPV = std::max(1, lines); }
+		// Best root moves of the last completed iteration, best first. Fewer than set if search was
+		// cancelled while searching the later lines
+		const std::vector<RootLine>& rootLines() const { return lines; }
+		// Nodes searched over every iteration of the most recent search
+		uint64_t nodes() const { return searchNodes; }
+		// Expected reply to the best move, taken from the principal variation
+		Move ponderMove() const { return bestLine.length() > 1 ? bestLine[1] : Move(); }
 	private:
 		// SearchStatistics encapsulates the statistics from a search iteration
 		struct SearchStatistics {
@@ -46,10 +89,24 @@ namespace SandalBot {
 			int seldepth{}; // Maximum selective depth of search
 			int eval{}; // Evaluation of position
 			uint64_t duration{}; // Duration of search
+			uint64_t lazyExits{}; // Number of lazy evaluation early exits
+			uint64_t lazyProbes{}; // Number of window aware evaluations
+			uint64_t ttProbes{}; // Number of transposition table lookups
+			uint64_t ttHits{}; // Number of lookups finding the position
+			uint64_t ttCutoffs{}; // Number of lookups returning an evaluation
+			uint64_t ttCollisions{}; // Number of lookups finding another position in the slot
+			uint64_t betaCutoffs{}; // Number of beta cutoffs in regular search
+			uint64_t firstMoveCutoffs{}; // Number of beta cutoffs by the first move searched
+			uint64_t cutoffIndexSum{}; // Sum of the index of the move causing each beta cutoff
+			uint64_t reductions{}; // Number of late move reductions
+			uint64_t reSearches{}; // Number of reduced moves searched again at full depth
+			uint64_t standPats{}; // Number of quiescence nodes cut off by the static evaluation
+			uint64_t standPatProbes{}; // Number of quiescence nodes evaluated
+			double branchingFactor{}; // Nodes of this iteration over nodes of the previous iteration
 
-			std::string prepareEval();
 			void printIteration();
-			void print(Searcher* searcher);
+			IterationReport report(const Searcher* searcher) const;
+			std::string statsString(StatsFormat format) const;
 		};
 		const Move nullMove{}; // 'Null' move, represents uninitialised move to compare to
 
@@ -58,10 +115,13 @@ namespace SandalBot {
 		std::atomic<bool> cancelSearch{ false }; // Atomic boolean indicates if search has been cancelled
 		// Atomic boolean indicates if search has completed prematurely (checkmate)
 		std::atomic<bool> searchCompleted{ false };
+		// Set by prepareSearch, so the next search keeps a stop which arrived before it started
+		std::atomic<bool> searchPrepared{ false };
 		std::mutex searchMutex; // Used to lock searchStop
 		std::condition_variable searchStop; // Conditional variable waits to synchronise class during search
 
-		static constexpr int searchWaitPeriod{ 100 }; // Sleep time for sleeping thread
+		// Nodes searched between checks of the clock and node limit, well under a millisecond of search
+		static constexpr uint64_t pollInterval{ 1024 };
 		static constexpr int maxDeepening{ 256 }; // Maximum iterative deepening depth
 		static constexpr int reduceExtensionCutoff{ 3 }; // Move array index where depth is reduced
 		static constexpr int maxExtensions{ 16 }; // Maximum number of extensions during search
@@ -71,22 +131,68 @@ namespace SandalBot {
 
 		Board* board{ nullptr };
 
-		TranspositionTable tTable{}; // Store previously evaluated positions
+		// Store previously evaluated positions. A table shared between searchers is read and written
+		// without locks, so concurrent searches may read each other's partly written entries. These
+		// only cost search quality, as table moves are checked for legality before they are played
+		std::shared_ptr<TranspositionTable> tTable{ std::make_shared<TranspositionTable>() };
+		TranspositionTable::ProbeCounters ttCounters{}; // Lookups of this searcher in the current iteration
+		TimeManager timeManager{}; // Allots time of timed searches
+		bool timedSearch{ false }; // Whether search is cancelled at the maximum time
+		uint64_t nodeLimit{ std::numeric_limits<uint64_t>::max() }; // Nodes after which search is cancelled
+		uint64_t nodesUntilPoll{ pollInterval }; // Nodes left until limits are next checked
+
+		// Time limits a ponder search switches to on ponderhit, a move time of zero uses the clock
+		struct PonderLimits {
+			int timeMs{};
+			int incMs{};
+			int movesToGo{};
+			int moveTimeMs{};
+		};
+		PonderLimits ponderLimits{};
+		bool ponderSearch{ false }; // Whether the current search ponders until ponderhit
+		std::atomic<bool> ponderHitReceived{ false }; // Set by ponderhit, cleared once a search ends
 
 		Move currentMove{};
 
+		// Whether search generates pseudo legal moves and checks legality only for moves which are made
+		bool pseudoLegal{ false };
+		SearchListener* listener{ nullptr }; // Receives iterations, current moves and diagnostics
+		// Whether iterations are reported to the listener
+		bool reportIterations{ true };
+		// Whether hardware performance counters are reported after each search
+		bool perfCounters{ false };
+		StatsFormat statsFormat{ StatsFormat::OFF };
+
+		int depthLimit{ maxDeepening }; // Deepest iteration searched
+		int mateLimit{ 0 }; // Moves of a mate which ends search, zero ends search at any mate
+		std::vector<Move> searchMoves{}; // Root moves searched, all when empty
+
+		// Each iteration searches the root once per line, excluding the moves of the lines before it.
+		// Lines after the first share the table and move ordering state below the root, so they
+		// mostly cost the root moves whose scores are not yet known
+		int multiPV{ 1 };
+		int lineCount{ 1 }; // Lines of the current search, no more than there are root moves
+		std::vector<RootLine> lines{};
+		std::vector<Move> excludedRootMoves{};
+		MoveLine linePV{}; // Principal variation of the line being generated
+		uint64_t searchNodes{}; // Nodes searched over all iterations
+
 		// Using min cannot be negated due to two complement range
 		static constexpr int defaultAlpha{ std::numeric_limits<int>::min() + 1 };
 		static constexpr int defaultBeta{ std::numeric_limits<int>::max() };
 
 		void iterativeSearch();
 		int negaMax(int alpha, int beta, int depth, int maxDepth, int numExtensions);
-		uint64_t moveSearch(int depth, int maxDepth);
 		int quiescenceSearch(int alpha, int beta, int maxDepth);
-		bool worthSearching(Move move, const bool isCheck, const int numExtensions);
-		void moveSleep(int moveTimeMs);
-		void generateBestLine(Move bestMove);
-		void enactBestLine(Move move, int depth);
+		bool worthSearching(Move move, const bool givesCheck, const int numExtensions);
+		void runSearch(bool isTimed);
+		void beginSearch();
+		void checkLimits();
+		int restrictRootMoves(MovePoint moves[], int numMoves);
+		void startAllottedTime();
+		void searchOtherLines(int depth, int eval);
+		void generateBestLine(Move bestMove, MoveLine& line);
+		void enactBestLine(Move move, int depth, MoveLine& line);
 		bool isPositionIllegal();
 	};
 
@@ -10,7 +10,9 @@ namespace SandalBot {
 	class StateHistory {
 	public:
 		StateHistory();
+		StateHistory(const StateHistory& other);
 		~StateHistory();
+		StateHistory& operator=(const StateHistory& other);
 
 		void push(const BoardState& state);
 		void pop();
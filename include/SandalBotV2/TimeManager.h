@@ -0,0 +1,53 @@
+#ifndef TIMEMANAGER_H
+#define TIMEMANAGER_H
+
+#include "Move.h"
+
+#include <chrono>
+#include <limits>
+
+namespace SandalBot {
+
+	// TimeManager allots search time for a move. From the clock, increment and moves to go it computes
+	// an optimum time, which the search aims for, and a maximum time, after which the search is
+	// cancelled. After each iteration the optimum is scaled: a best move which has been stable for
+	// several iterations ends the search early, while best move changes and score drops extend it
+	class TimeManager {
+	public:
+		static constexpr int defaultMoveOverheadMs{ 30 };
+
+		void initClock(int timeMs, int incMs, int movesToGo);
+		void initFixed(int moveTimeMs);
+		void initInfinite();
+		void setMoveOverhead(int overheadMs) { moveOverheadMs = overheadMs; }
+		int optimum() const { return optimumMs; }
+		int maximum() const { return maximumMs; }
+		int elapsed() const;
+		// Whether the maximum time is up, checked by search with the precision of the steady clock
+		bool outOfTime() const { return std::chrono::steady_clock::now() >= deadline; }
+		bool stopAfterIteration(Move bestMove, int eval);
+	private:
+		// Moves the remaining time is spread over when the number of moves to go is unknown
+		static constexpr int defaultMovesToGo{ 40 };
+		static constexpr int maxMovesToGo{ 50 };
+		// Iterations the best move must survive unchanged before the search is shortened
+		static constexpr int stableIterations{ 4 };
+		// Score drop in centipawns between iterations which extends the search
+		static constexpr int scoreDropMargin{ 30 };
+
+		std::chrono::steady_clock::time_point start{};
+		std::chrono::steady_clock::time_point deadline{}; // Start plus the maximum time
+		int moveOverheadMs{ defaultMoveOverheadMs };
+		int optimumMs{};
+		int maximumMs{};
+		bool adaptive{ false }; // Whether iteration results adjust the time used
+
+		Move previousBestMove{};
+		int previousEval{};
+		int iterations{};
+		int stability{}; // Consecutive iterations without a best move change
+	};
+
+}
+
+#endif // !TIMEMANAGER_H
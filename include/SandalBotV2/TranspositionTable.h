@@ -5,6 +5,8 @@
 #include "Types.h"
 #include "ZobristHash.h"
 
+#include <atomic>
+#include <cstdint>
 #include <iostream>
 #include <limits>
 
@@ -13,7 +15,8 @@ namespace SandalBot {
 	// TranspositionTable inherits from ZobristHash to apply zobrist hashing techniques
 	// for a hashtable of previously visited positions. Using hashes as indexes, positions'
 	// evaluation, bestmove, and other information can be stored to avoid recomputation - 
-	// drastically reduced search tree sizes in repetitive positions
+	// drastically reduced search tree sizes in repetitive positions. A table may be shared by searchers
+	// on several threads, so it keeps no counters of its own and is never reallocated once created
 	class TranspositionTable {
 	public:
 		// Sentinel value for evaluation
@@ -22,58 +25,56 @@ namespace SandalBot {
 		static constexpr uint8_t exact{ 0 };
 		static constexpr uint8_t lowerBound{ 1 };
 		static constexpr uint8_t upperBound{ 2 };
-		// Size of table and number of slots filled
+		// Counters for lookups, entries with a matching key, lookups returning an evaluation, and
+		// lookups finding the slot occupied by another position. Kept by the caller of lookup, so
+		// searchers sharing a table each count their own lookups
+		struct ProbeCounters {
+			uint64_t probes{};
+			uint64_t hits{};
+			uint64_t cutoffs{};
+			uint64_t collisions{};
+		};
+		// Size of table
 		std::size_t size{};
-		std::size_t slotsFilled{};
 
 		TranspositionTable(int sizeMB = defaultSizeMB);
 		~TranspositionTable() { delete[] table; }
-		TranspositionTable& operator=(const TranspositionTable& other);
+		TranspositionTable(const TranspositionTable&) = delete;
+		TranspositionTable& operator=(const TranspositionTable&) = delete;
 		Move getBestMove(HashKey hashKey);
 		int getDepth(HashKey hashKey);
 		void store(int eval, int16_t remainingDepth, int16_t currentDepth, uint8_t nodeType, Move move, HashKey hashKey);
-		int lookup(int16_t remainingDepth, int16_t currentDepth, int alpha, int beta, HashKey hashKey);
+		int lookup(int16_t remainingDepth, int16_t currentDepth, int alpha, int beta, HashKey hashKey, ProbeCounters& counters);
 		void clear();
+		int hashfull() const;
 		int retrieveMateScore(int eval, int16_t currentDepth);
 		int storeMateScore(int eval, int16_t currentDepth);
 	private:
-		// Hash table entry, storing positional information
+		// Hash table entry, storing positional information packed into one word of data. The key is
+		// stored xored with the data, so an entry torn by searchers on two threads writing at once fails
+		// the key check instead of pairing one position's key with another's evaluation or move
 		struct Entry {
-			HashKey hash{ 0ULL };
-			int eval{ 0 };
-			int16_t depth{ std::numeric_limits<int16_t>::max() };
-			uint8_t nodeType{}; // Determines whether node was an exact, upper, or lower bound of evaluation
-			Move move{};
-			Entry() {}
-			Entry(HashKey hash, int eval, uint16_t depth, uint8_t nodeType, Move move) 
-				: hash(hash), eval(eval), depth(depth), nodeType(nodeType), move(move) {}
-			Entry(Entry&& other) noexcept
-				: hash(other.hash), eval(other.eval), depth(other.depth), 
-				nodeType(other.nodeType), move(other.move) {}
+			std::atomic<uint64_t> key{};
+			std::atomic<uint64_t> data{};
+		};
+		// The move occupies the low 16 bits of the data, then the depth, the node type, which
+		// determines whether the node was an exact, upper, or lower bound of evaluation, and the
+		// evaluation in the high 30 bits
+		static constexpr int depthShift{ 16 };
+		static constexpr int nodeTypeShift{ 32 };
+		static constexpr int evalShift{ 34 };
 
-			Entry& operator=(const Entry& other) {
-				this->hash = other.hash;
-				this->eval = other.eval;
-				this->depth = other.depth;
-				this->nodeType = other.nodeType;
-				this->move = other.move;
+		static uint64_t pack(int eval, int16_t depth, uint8_t nodeType, Move move);
+		static Move unpackMove(uint64_t data) { return Move(uint16_t(data)); }
+		static int16_t unpackDepth(uint64_t data) { return int16_t(uint16_t(data >> depthShift)); }
+		static uint8_t unpackNodeType(uint64_t data) { return uint8_t((data >> nodeTypeShift) & 3); }
+		static int unpackEval(uint64_t data) { return int(int64_t(data) >> evalShift); }
 
-				return *this;
-			}
-			Entry& operator=(Entry&& other) noexcept {
-				this->hash = other.hash;
-				this->eval = other.eval;
-				this->depth = other.depth;
-				this->nodeType = other.nodeType;
-				this->move = other.move;
+		// Returns the data of the entry stored for the hash, false if the slot holds another position
+		bool read(HashKey hash, uint64_t& data) const;
 
-				return *this;
-			}
-		};
-		
 		static constexpr std::size_t defaultSizeMB = 128; // Default size of table in MB
 		Entry* table{ nullptr };
-		Move nullMove{};
 
 		std::size_t getIndex(HashKey hash) const { return hash % size; }
 	};
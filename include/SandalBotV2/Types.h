@@ -100,12 +100,12 @@ namespace SandalBot {
 	constexpr T operator+(T d1, int d2) { return T(int(d1) + d2); }    \
 	constexpr T operator-(T d1, int d2) { return T(int(d1) - d2); }    \
 	constexpr T operator-(T d) { return T(-int(d)); }                  \
-	inline T& operator+=(T& d1, int d2) { return d1 = d1 + d2; }       \
-	inline T& operator-=(T& d1, int d2) { return d1 = d1 - d2; }
+	constexpr T& operator+=(T& d1, int d2) { return d1 = d1 + d2; }    \
+	constexpr T& operator-=(T& d1, int d2) { return d1 = d1 - d2; }
 
 	#define ENABLE_INCR_OPERATORS_ON(T)                                \
-	inline T& operator++(T& d) { return d = T(int(d) + 1); }           \
-	inline T& operator--(T& d) { return d = T(int(d) - 1); }
+	constexpr T& operator++(T& d) { return d = T(int(d) + 1); }        \
+	constexpr T& operator--(T& d) { return d = T(int(d) - 1); }
 
 	#define ENABLE_FULL_OPERATORS_ON(T)                                \
 	ENABLE_BASE_OPERATORS_ON(T)                                        \
@@ -113,8 +113,8 @@ namespace SandalBot {
 	constexpr T operator*(T d, int i) { return T(int(d) * i); }        \
 	constexpr T operator/(T d, int i) { return T(int(d) / i); }        \
 	constexpr int operator/(T d1, T d2) { return int(d1) / int(d2); }  \
-	inline T& operator*=(T& d, int i) { return d = T(int(d) * i); }    \
-	inline T& operator/=(T& d, int i) { return d = T(int(d) / i); }
+	constexpr T& operator*=(T& d, int i) { return d = T(int(d) * i); } \
+	constexpr T& operator/=(T& d, int i) { return d = T(int(d) / i); }
 
 	ENABLE_INCR_OPERATORS_ON(PieceType)
 	ENABLE_INCR_OPERATORS_ON(Piece)
@@ -129,8 +129,8 @@ namespace SandalBot {
 
 	constexpr Square operator+(Square sq, Direction dir) { return Square(int(sq) + int(dir)); }
 	constexpr Square operator-(Square s, Direction d) { return Square(int(s) - int(d)); }
-	inline Square& operator+=(Square& s, Direction d) { return s = s + d; }
-	inline Square& operator-=(Square& s, Direction d) { return s = s - d; }
+	constexpr Square& operator+=(Square& s, Direction d) { return s = s + d; }
+	constexpr Square& operator-=(Square& s, Direction d) { return s = s - d; }
 
 	constexpr bool operator==(Square sq, CastlingRights cr) { return int(sq) == int(cr); }
 
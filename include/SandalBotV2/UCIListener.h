@@ -0,0 +1,42 @@
+#ifndef UCILISTENER_H
+#define UCILISTENER_H
+
+#include "BufferedWriter.h"
+#include "Move.h"
+#include "SearchListener.h"
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace SandalBot {
+
+	// UCIListener reports search and perft results as UCI output through a buffered writer. Each
+	// event is formatted into one block and written with a single flush, and perft divide lines are
+	// collected until the total is written with them, so no other response can split them. The root move being searched is only reported once a
+	// search has run for a while, as GUIs show it for long analysis and it would otherwise flood output
+	class UCIListener : public SearchListener {
+	public:
+		static constexpr uint64_t currentMoveDelayMs{ 3000 };
+
+		UCIListener(BufferedWriter& writer) : writer(writer) {}
+
+		void onIteration(const IterationReport& report) override;
+		void onCurrentMove(int depth, Move move, int moveNumber, uint64_t timeMs) override;
+		void onBestMove(Move move, Move ponder) override;
+		void onPerftMove(Move move, uint64_t nodes) override;
+		void onInfo(std::string_view text) override;
+		// Writes the collected divide lines followed by text, the total of the perft run
+		void writePerft(std::string_view text);
+
+		static std::string uciMove(Move move);
+	private:
+		BufferedWriter& writer;
+		std::string perftLines{}; // Divide lines of the running perft, only used on the search thread
+
+		static std::string score(int eval);
+	};
+
+}
+
+#endif // !UCILISTENER_H
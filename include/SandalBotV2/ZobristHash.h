@@ -3,6 +3,8 @@
 
 #include "Types.h"
 
+#include <array>
+
 namespace SandalBot {
 
 	class Board;
@@ -13,13 +15,12 @@ namespace SandalBot {
 	// allows progressive changes to hash and ability to revert changes.
 	namespace ZobristHash {
 
+		// Hash values are generated at compile time from a fixed seed
 		// Hash values of each piece for both colors for every square
-		extern HashKey pieceHashes[2][7][64];
-		extern HashKey enPassantHash[64]; // Hash values for each en passant target square
-		extern HashKey castlingRightsHash[17]; // Hashes for each castling right
-		extern HashKey whiteMoveHash; // Hash for sides turn
-
-		void initHashes();
+		extern const std::array<std::array<std::array<HashKey, SQUARES_NB>, PIECE_TYPE_NB>, COLOR_NB> pieceHashes;
+		extern const std::array<HashKey, SQUARES_NB> enPassantHash; // Hash values for each en passant target square
+		extern const std::array<HashKey, RIGHTS_NB> castlingRightsHash; // Hashes for each castling right
+		extern const HashKey whiteMoveHash; // Hash for sides turn
 
 		HashKey hashBoard(Board* board);
 	};
@@ -0,0 +1,156 @@
+#include "AttackInfo.h"
+
+#include "Bitboards.h"
+#include "Board.h"
+#include "KoggeStone.h"
+
+namespace SandalBot {
+
+	// Computes attack maps of the side not to move, and check and pin data for the side to move
+	void AttackInfo::compute(const Board* board) {
+		checkers = 0ULL;
+		checkMask = 0ULL;
+		pinned = 0ULL;
+
+		if (board->sideToMove() == WHITE) {
+			computeAttacks<BLACK>(board);
+			computeCheckData<WHITE>(board);
+		} else {
+			computeAttacks<WHITE>(board);
+			computeCheckData<BLACK>(board);
+		}
+
+		key = board->state->zobristHash;
+		occupied = board->typesBB[ALL_PIECES];
+		valid = true;
+		sideToMoveComputed = false;
+		checkSquaresComputed = false;
+	}
+
+	// Computes attack maps of the side to move, only required by evaluation
+	void AttackInfo::computeSideToMove(const Board* board) {
+		board->sideToMove() == WHITE ? computeAttacks<WHITE>(board) : computeAttacks<BLACK>(board);
+		sideToMoveComputed = true;
+	}
+
+	// Computes the squares giving check to the enemy king, only required to detect checking moves
+	void AttackInfo::computeCheckSquares(const Board* board) {
+		board->sideToMove() == WHITE ? computeCheckSquares<WHITE>(board) : computeCheckSquares<BLACK>(board);
+		checkSquaresComputed = true;
+	}
+
+	// Computes the squares attacked by each piece type of one side
+	template <Color Us>
+	void AttackInfo::computeAttacks(const Board* board) {
+		Bitboard allPieces = board->typesBB[ALL_PIECES];
+		Bitboard* usAttacks = attacks[Us];
+
+		// Pawns and knights are shifted set-wise, independent of the number of pieces
+		usAttacks[PAWN] = pawnAttacks<Us>(board->typesBB[PAWN] & board->colorsBB[Us]);
+		usAttacks[KNIGHT] = knightAttacks(board->typesBB[KNIGHT] & board->colorsBB[Us]);
+
+		// Sliders only contribute to the union of their type, so they are filled set-wise too
+		Bitboard empty = ~allPieces;
+		Bitboard bishops = board->typesBB[BISHOP] & board->colorsBB[Us];
+		Bitboard rooks = board->typesBB[ROOK] & board->colorsBB[Us];
+		Bitboard queens = board->typesBB[QUEEN] & board->colorsBB[Us];
+
+		usAttacks[BISHOP] = KoggeStone::diagonalUnion(bishops, empty);
+		usAttacks[ROOK] = KoggeStone::orthogonalUnion(rooks, empty);
+		usAttacks[QUEEN] = KoggeStone::diagonalUnion(queens, empty) | KoggeStone::orthogonalUnion(queens, empty);
+
+		usAttacks[KING] = getMovementBoard<KING>(board->kingSquares[Us], allPieces);
+
+		usAttacks[ALL_PIECES] = usAttacks[PAWN] | usAttacks[KNIGHT] | usAttacks[BISHOP]
+			| usAttacks[ROOK] | usAttacks[QUEEN] | usAttacks[KING];
+	}
+
+	// Calculates checking pieces, the squares which resolve a check, and pinned pieces
+	// for the side to move Us
+	template <Color Us>
+	void AttackInfo::computeCheckData(const Board* board) {
+		Square kSq = board->kingSquares[Us];
+		Bitboard kingBB = 1ULL << kSq;
+		Bitboard allPieces = board->typesBB[ALL_PIECES];
+		Bitboard enemyBoard = board->colorsBB[~Us];
+		Bitboard enemyOrthogonals = enemyBoard & (board->typesBB[ROOK] | board->typesBB[QUEEN]);
+		Bitboard enemyDiagonals = enemyBoard & (board->typesBB[BISHOP] | board->typesBB[QUEEN]);
+
+		Bitboard orthogonalCheckers = getMovementBoard<ROOK>(kSq, allPieces) & enemyOrthogonals;
+		Bitboard diagonalCheckers = getMovementBoard<BISHOP>(kSq, allPieces) & enemyDiagonals;
+
+		checkers = orthogonalCheckers | diagonalCheckers;
+		checkers |= getMovementBoard<KNIGHT>(kSq, allPieces) & enemyBoard & board->typesBB[KNIGHT];
+		checkers |= getPawnAttackMoves<Us>(kSq) & enemyBoard & board->typesBB[PAWN];
+
+		opponentAttacks = attacks[~Us][ALL_PIECES];
+
+		// Checking sliders also attack the squares behind the king, which the king cannot retreat to
+		Bitboard sliderCheckers = orthogonalCheckers | diagonalCheckers;
+		while (sliderCheckers != 0ULL) {
+			Square from = popLSB(sliderCheckers);
+			Bitboard xrayBlockers = allPieces & ~kingBB;
+
+			if (orthogonalCheckers & (1ULL << from)) {
+				opponentAttacks |= getMovementBoard<ROOK>(from, xrayBlockers);
+			}
+			if (diagonalCheckers & (1ULL << from)) {
+				opponentAttacks |= getMovementBoard<BISHOP>(from, xrayBlockers);
+			}
+		}
+
+		// Pieces may block or capture a single checker
+		Bitboard temp = checkers;
+		while (temp != 0ULL) {
+			Square from = popLSB(temp);
+			checkMask |= (getLineBetweenBB(kSq, from) & ~kingBB) | (1ULL << from);
+		}
+
+		// Enemy sliders which would see the king on an empty board may pin a single friendly piece
+		Bitboard snipers = (getMovementBoard<ROOK>(kSq, 0ULL) & enemyOrthogonals)
+			| (getMovementBoard<BISHOP>(kSq, 0ULL) & enemyDiagonals);
+
+		while (snipers != 0ULL) {
+			Square from = popLSB(snipers);
+			Bitboard between = getLineBetweenBB(kSq, from) & allPieces & ~kingBB & ~(1ULL << from);
+
+			// Exactly one piece between king and sniper
+			if (between != 0ULL && (between & (between - 1ULL)) == 0ULL) {
+				pinned |= between & board->colorsBB[Us];
+			}
+		}
+	}
+
+
+	// Calculates the squares each piece type of Us gives check from, and the pieces of Us
+	// which are the only blocker between a slider of Us and the enemy king
+	template <Color Us>
+	void AttackInfo::computeCheckSquares(const Board* board) {
+		Square kSq = board->kingSquares[~Us];
+		Bitboard allPieces = board->typesBB[ALL_PIECES];
+		Bitboard friendlyBoard = board->colorsBB[Us];
+
+		checkSquares[PAWN] = getPawnAttackMoves<~Us>(kSq);
+		checkSquares[KNIGHT] = getMovementBoard<KNIGHT>(kSq, allPieces);
+		checkSquares[BISHOP] = getMovementBoard<BISHOP>(kSq, allPieces);
+		checkSquares[ROOK] = getMovementBoard<ROOK>(kSq, allPieces);
+		checkSquares[QUEEN] = checkSquares[BISHOP] | checkSquares[ROOK];
+		checkSquares[KING] = 0ULL;
+
+		discoveredCandidates = 0ULL;
+		Bitboard snipers = (getMovementBoard<ROOK>(kSq, 0ULL) & (board->typesBB[ROOK] | board->typesBB[QUEEN]))
+			| (getMovementBoard<BISHOP>(kSq, 0ULL) & (board->typesBB[BISHOP] | board->typesBB[QUEEN]));
+		snipers &= friendlyBoard;
+
+		while (snipers != 0ULL) {
+			Square from = popLSB(snipers);
+			Bitboard between = getLineBetweenBB(kSq, from) & allPieces & ~(1ULL << kSq) & ~(1ULL << from);
+
+			// Exactly one friendly piece between sniper and king
+			if (between != 0ULL && (between & (between - 1ULL)) == 0ULL) {
+				discoveredCandidates |= between & friendlyBoard;
+			}
+		}
+	}
+
+}
@@ -0,0 +1,160 @@
+#include "Bench.h"
+
+#include "Board.h"
+#include "FEN.h"
+#include "MoveOrderer.h"
+#include "PerfCounters.h"
+#include "Searcher.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+namespace SandalBot::Bench {
+
+	using namespace std::literals::string_view_literals;
+
+	const array<string_view, positionCount> positions{
+		FEN::startpos,
+			"r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq -"sv,
+			"8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - -"sv,
+			"r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1"sv,
+			"rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8"sv,
+			"r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 w - - 0 10"sv,
+			"R6R/3Q4/1Q4Q1/4Q3/2Q4Q/Q4Q2/pp1Q4/kBNN1KB1 w - - 0 1"sv,
+			"r2qb1rk/ppb2p1p/2n1pPp1/B3N3/2B1P2Q/2P2R2/1P4PP/7K w - - 0 1"sv,
+			"8/8/6p1/7k/3r2NP/B5PK/2br1R2/8 w - - 0 1"sv,
+			"3q1rk1/ppp1nb1p/2n1B1p1/3P1p2/2P5/1PB2N1P/PQ3PP1/5RK1 w - - 0 1"sv,
+			"4rk2/3q1p1p/1pn3p1/p1pNp3/4P3/1PP2Q2/P4PPP/2B2RK1 w - - 0 1"sv,
+			"6qk/8/5P1p/8/8/6QP/5PP1/4R1K1 w - - 0 1"sv,
+			"5n1r/5N2/ppp3r1/7k/3P1R1p/5P1N/PP3K2/6R1 w - - 0 1"sv,
+			"8/R7/1p1k2bN/pP1P2p1/3K3p/7P/8/4B3 w - - 0 1"sv,
+			"2B5/8/3K4/1p6/2k5/P4P2/1B6/N4N2 w - - 0 1"sv,
+			"q1nrrk2/6pp/5pbb/8/8/1B6/3B1Q2/4RK2 w - - 0 1"sv,
+			"8/3K4/2R1P3/1P1kr3/3Npb2/4P3/8/5N2 w - - 0 1"sv,
+			"r7/6p1/6pk/4Q1N1/6pK/5N2/8/1b6 w - - 0 1"sv,
+			"B3b3/2p5/P1Rp4/PK1k1P2/3p1P2/3P4/1R6/8 w - - 0 1"sv,
+			"8/7p/8/8/3p4/3P2RR/6PP/5K1k w - - 0 1"sv,
+			"k7/1q6/2N5/2NNN3/8/8/1K5R/8 w - - 0 1"sv,
+			"8/8/4B3/R6r/p1p1pr2/3kP3/3P1P2/3K3N w - - 0 1"sv,
+			"2kq1r2/p7/2p5/1pR5/1K1P1p2/1PP2R2/P2r4/5Q2 b - - 0 1"sv,
+			"k1K5/p7/8/2n5/8/8/7B/R7 w - - 0 1"sv,
+			"1b6/1B2pQ2/8/4k1B1/3r4/1N1R4/5n2/1K5b w - - 0 1"sv,
+			"8/2K1Qp1b/2p5/1k6/8/RBp3r1/8/1R6 w - - 0 1"sv,
+			"8/8/8/2N5/B1p1Q3/4n3/p3R3/B1kn2K1 w - - 0 1"sv,
+			"2R5/kpb1P1P1/1p6/1P6/K7/8/8/8 w - - 0 1"sv,
+			"8/pk1B4/p7/2K1p3/8/8/4Q3/8 w - - 0 1"sv,
+			"1q5k/4R3/8/8/1p6/1B6/5R2/1K6 w - - 0 1"sv,
+			"4r1b1/1p4B1/pN2pR2/RB2k3/1P2N2p/n1p3b1/3P1p1r/5K1n w - - 0 1"sv,
+			"7k/8/5N1P/8/2p5/2N5/8/3K3R w - - 0 1"sv,
+			"8/1Q1K3n/1B6/1k6/8/8/1P6/8 w - - 0 1"sv,
+			"8/1p3K1p/8/5p2/2Q2P2/k1P4B/3R4/1q6 w - - 0 1"sv,
+			"k1K5/p7/2N5/1P6/4pP2/2p1P3/pp6/r3Q3 w - - 0 1"sv,
+			"n1N3br/4Bpkr/1pP2R1b/pP1pnPpR/Pp4P1/1P6/1K1P4/8 w - - 0 1"sv,
+			"b1B1k3/pr6/8/P6p/1P6/2P2q2/1K6/8 b - - 0 1"sv,
+			"3K2B1/1p6/1r6/rk2N3/b1p5/1pP5/1P3P2/8 b - - 0 1"sv,
+			"r1b2nrk/pp3ppp/1q2p3/2bpn1N1/5N2/2PQ4/PPB2PPP/R1B2RK1 w - - 0 1"sv,
+			"2kr4/K1pp4/1p6/8/8/8/7Q/3R4 w - - 0 1"sv,
+			"N4Q2/nk1P4/8/8/4K3/8/8/8 w - - 0 1"sv,
+			"b7/N3B3/Q7/3kpp2/3p4/1R4P1/8/7K w - - 0 1"sv,
+			"r1bk3r/pppp4/3N4/3N2qn/2Kbppp1/P7/1PPPB1P1/R1BQ3R w - - 0 1"sv,
+			"rnb2rk1/pp3ppp/1b6/3q4/3pN3/Q4N2/PPP2KPP/R1B1R3 w - - 0 1"sv,
+			"8/4p3/7B/4p3/4k1P1/8/5K2/3R4 w - - 0 1"sv,
+			"kbK5/pp6/1P6/8/8/8/R7/8 w - - 0 1"sv,
+			"N1bk3r/P5pp/3b1p2/3B4/R2nP1nq/3P3N/1BP3KP/4Q2R b - - 0 1"sv,
+			"r2q1bkr/p4p1p/1p3p1B/2b1n3/2ppN3/2P2N2/PP3PPP/R2QR1K1 w - - 0 1"sv,
+			"7k/R7/3R1K2/r4p2/5P2/8/6r1/8 w - - 0 1"sv,
+			"1n2qr1k/pb3p1r/1p1p4/2pPpNQB/2P1n3/P1P5/5P2/3RKB1R w - - 0 1"sv,
+			"8/p5Q1/2ppq2p/3n1ppk/3B4/2P2P1P/P5P1/6K1 w - - 0 1"sv,
+			"Q1b2rk1/2p1bppp/p7/1p2n3/P4n2/1BPq4/1P1P1PPP/RNB2RK1 b - - 0 1"sv,
+			"5rk1/pbr2pbp/1q2p1pQ/3p4/1P1N4/P2BP3/1B3PPP/5RK1 w - - 0 1"sv,
+			"r1r2knR/5p2/p3bPp1/1p2P3/1q1p4/2NB2R1/PP1Q1P2/1K6 w - - 0 1"sv,
+			"r2qk2r/ppp2pp1/8/4N3/3bQ3/2P3p1/PP3PP1/RNB2RK1 w - - 0 1"sv,
+			"r7/ppp1kp2/1bnp1n2/P3p3/1PB1P3/2PP3b/5P1P/RN2R1K1 b - - 0 1"sv,
+			"2r3k1/Q4Rpp/p1q1n3/P2pP3/8/1pP5/1P4PP/5RK1 w - - 0 1"sv,
+			"5r1k/1p4pp/p7/1q1QN3/8/1P6/P3p1PP/6K1 w - - 0 1"sv,
+			"8/8/8/6pp/6pk/1R6/6KP/8 w - - 0 1"sv,
+			"4r1k1/pp4pp/2p5/3p3n/3P2n1/1PP2R2/P1B3P1/R1B1r1NK b - - 0 1"sv,
+			"rnbq1knr/ppb4p/3NpPp1/3p4/1P1p1Q2/P7/2PB1PPP/R2QKBNR w KQ - 0 1"sv,
+			"8/k7/3p4/p2P1p2/P2P1P2/8/8/K7 w - - 0 1"sv,
+			"2k3r1/2p1q1r1/p3b2p/1p3B2/8/2N5/PP1BQPPP/2R2RK1 b - - 0 1"sv,
+			"6k1/2QN1p1p/p3p1p1/3pP1N1/1r3n2/8/5PPP/5K2 b - - 3 31"sv
+	};
+
+	Result run(int depth, int threads, int hashSizeMB, ostream& out, bool perfCounters) {
+		depth = max(depth, 1);
+		threads = clamp(threads, 1, int(positions.size()));
+		hashSizeMB = clamp(hashSizeMB, 1, maxHashSizeMB);
+
+		vector<uint64_t> positionNodes(positions.size(), 0ULL);
+		atomic<size_t> nextPosition{ 0 };
+
+		// Positions are handed out in order to threads as they become free
+		auto work = [&]() {
+			Board board;
+			Searcher searcher(&board);
+			searcher.changeHashSize(hashSizeMB);
+			searcher.setReportIterations(false);
+
+			for (size_t i = nextPosition++; i < positions.size(); i = nextPosition++) {
+				board.loadPosition(positions[i]);
+				searcher.clearHash();
+				searcher.orderer = MoveOrderer();
+
+				searcher.searchToDepth(depth);
+				positionNodes[i] = searcher.nodes();
+			}
+		};
+
+		// Counters are opened before workers are created so they inherit them
+		PerfCounters counters;
+		if (perfCounters) {
+			counters.start();
+		}
+
+		auto start = chrono::high_resolution_clock::now();
+
+		vector<thread> workers;
+		for (int i = 1; i < threads; ++i) {
+			workers.emplace_back(work);
+		}
+		work();
+
+		for (thread& worker : workers) {
+			worker.join();
+		}
+
+		chrono::duration<double> duration = chrono::high_resolution_clock::now() - start;
+
+		if (perfCounters) {
+			counters.stop();
+		}
+
+		Result result{ 0ULL, duration.count() };
+		for (size_t i = 0; i < positions.size(); ++i) {
+			out << "Position " << (i + 1) << '/' << positions.size() << " (" << positions[i] << "): "
+				<< positionNodes[i] << " nodes\n";
+			result.nodes += positionNodes[i];
+		}
+
+		// Prevent division by zero
+		double seconds = max(result.seconds, 1e-9);
+		out << "\n";
+		out << "Total time (ms) : " << uint64_t(result.seconds * 1000.0) << '\n';
+		out << "Nodes searched  : " << result.nodes << '\n';
+		out << "Nodes/second    : " << uint64_t(result.nodes / seconds) << endl;
+
+		if (perfCounters) {
+			counters.report(out, result.nodes);
+		}
+
+		return result;
+	}
+
+}
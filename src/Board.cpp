@@ -21,6 +21,35 @@ namespace SandalBot {
 		loadPosition(FEN::startpos);
 	}
 
+	// Copies the position and its full history, used to give each thread its own board
+	Board::Board(const Board& other) {
+		*this = other;
+	}
+
+	Board& Board::operator=(const Board& other) {
+		if (this == &other) {
+			return *this;
+		}
+
+		std::copy(std::begin(other.squares), std::end(other.squares), squares);
+		history = other.history;
+		stateHistory = other.stateHistory;
+		state = &stateHistory.back();
+
+		std::copy(std::begin(other.typesBB), std::end(other.typesBB), typesBB);
+		std::copy(std::begin(other.colorsBB), std::end(other.colorsBB), colorsBB);
+		std::copy(std::begin(other.kingSquares), std::end(other.kingSquares), kingSquares);
+		std::copy(std::begin(other.pieceCount), std::end(other.pieceCount), pieceCount);
+		std::copy(std::begin(other.sideValues), std::end(other.sideValues), sideValues);
+		std::copy(std::begin(other.pieceSquareValues), std::end(other.pieceSquareValues), pieceSquareValues);
+		std::copy(std::begin(other.MMPieces), std::end(other.MMPieces), MMPieces);
+
+		mSideToMove = other.mSideToMove;
+		mMoveCounter = other.mMoveCounter;
+		attackInfo = other.attackInfo;
+		return *this;
+	}
+
 	// Parses a given FEN string and initialises position accordingly
 	void Board::loadPosition(std::string_view fen) {
 		PositionInfo newPos { FEN::fenToPosition(fen) }; // Extract info from FEN string
@@ -77,6 +106,7 @@ namespace SandalBot {
 		history.push(state->zobristHash, false);
 
 		initBitboards(); // Init bitboards
+		attackInfo.valid = false;
 	}
 
 	// Synchronise the board position with the bitboards
@@ -281,6 +311,212 @@ namespace SandalBot {
 		printBB(typesBB[ALL_PIECES]);
 	}
 
+	// Returns pieces of both colors attacking a square. Sliders are blocked by the given occupancy,
+	// which allows testing positions after a move without making it
+	Bitboard Board::attackersTo(Square square, Bitboard occupied) const {
+		Bitboard orthogonals = typesBB[ROOK] | typesBB[QUEEN];
+		Bitboard diagonals = typesBB[BISHOP] | typesBB[QUEEN];
+
+		// A pawn attacks a square if a pawn of the opposite color on that square would attack it
+		return (getPawnAttackMoves<WHITE>(square) & typesBB[PAWN] & colorsBB[BLACK])
+			| (getPawnAttackMoves<BLACK>(square) & typesBB[PAWN] & colorsBB[WHITE])
+			| (getMovementBoard<KNIGHT>(square, occupied) & typesBB[KNIGHT])
+			| (getMovementBoard<KING>(square, occupied) & typesBB[KING])
+			| (getMovementBoard<ROOK>(square, occupied) & orthogonals)
+			| (getMovementBoard<BISHOP>(square, occupied) & diagonals);
+	}
+
+	// Returns whether a pseudo legal move leaves the own king out of check. Only the moving piece is
+	// tested, so pin data for the whole position is never computed
+	bool Board::isLegal(Move move) {
+		Color us = mSideToMove;
+		Square from = move.from();
+		Square to = move.to();
+		Square kSq = kingSquares[us];
+		Bitboard toBB = 1ULL << to;
+		Bitboard enemies = colorsBB[~us];
+		Bitboard occupied = typesBB[ALL_PIECES];
+
+		// Castling out of, through, or into check is illegal
+		if (move.flag() == Move::Flag::CASTLE) {
+			Bitboard path = (to > from ? shortCastleCheckSQ[us] : longCastleCheckSQ[us]) | (1ULL << from);
+			while (path != 0ULL) {
+				if (attackersTo(popLSB(path), occupied) & enemies) {
+					return false;
+				}
+			}
+			return true;
+		}
+
+		// The king may not step onto an attacked square, including squares behind it on a checking line
+		if (from == kSq) {
+			return (attackersTo(to, occupied ^ (1ULL << from)) & enemies) == 0ULL;
+		}
+
+		// En passant removes two pieces from their squares, so the king is tested on the resulting occupancy
+		if (move.flag() == Move::Flag::EN_PASSANT) {
+			Bitboard captured = 1ULL << (to - pawnPush(us));
+			occupied = (occupied ^ (1ULL << from) ^ captured) | toBB;
+			return (attackersTo(kSq, occupied) & enemies & ~captured) == 0ULL;
+		}
+
+		// Other moves must capture or block a single checker
+		Bitboard checkers = this->checkers();
+		if (checkers != 0ULL) {
+			if ((checkers & (checkers - 1ULL)) != 0ULL) {
+				return false;
+			}
+			if (((getLineBetweenBB(kSq, LSB(checkers)) | checkers) & toBB) == 0ULL) {
+				return false;
+			}
+		}
+
+		// Only a piece on a line with the king, leaving that line, can uncover an attack on it
+		Bitboard line = getLineBB(kSq, from);
+		if (line == 0ULL || (line & toBB)) {
+			return true;
+		}
+
+		occupied = (occupied ^ (1ULL << from)) | toBB;
+		Bitboard orthogonals = (typesBB[ROOK] | typesBB[QUEEN]) & enemies & ~toBB;
+		Bitboard diagonals = (typesBB[BISHOP] | typesBB[QUEEN]) & enemies & ~toBB;
+
+		return ((getMovementBoard<ROOK>(kSq, occupied) & orthogonals) | (getMovementBoard<BISHOP>(kSq, occupied) & diagonals)) == 0ULL;
+	}
+
+	// Returns whether a legal move checks the enemy king. Direct checks are read from the check squares
+	// of the moving piece, discovered checks from the pieces blocking a friendly slider. Only promotions,
+	// en passant and castling, which change more than the moving piece, test the position after the move
+	bool Board::givesCheck(Move move, const AttackInfo& info) const {
+		Color us = mSideToMove;
+		Square from = move.from();
+		Square to = move.to();
+		Move::Flag flag = move.flag();
+		Square enemyKing = kingSquares[~us];
+		Bitboard toBB = 1ULL << to;
+
+		// A promoting pawn checks as its new piece
+		if (!move.isPromotion() && (info.checkSquares[typeOf(squares[from])] & toBB)) {
+			return true;
+		}
+
+		if ((info.discoveredCandidates & (1ULL << from)) && !(getLineBB(from, enemyKing) & toBB)) {
+			return true;
+		}
+
+		Bitboard occupied = typesBB[ALL_PIECES] ^ (1ULL << from);
+
+		switch (flag) {
+		case Move::Flag::EN_PASSANT: {
+			// The captured pawn may be the only blocker in front of a friendly slider
+			occupied = (occupied ^ (1ULL << (to - pawnPush(us)))) | toBB;
+			Bitboard orthogonals = (typesBB[ROOK] | typesBB[QUEEN]) & colorsBB[us];
+			Bitboard diagonals = (typesBB[BISHOP] | typesBB[QUEEN]) & colorsBB[us];
+			return (getMovementBoard<ROOK>(enemyKing, occupied) & orthogonals) | (getMovementBoard<BISHOP>(enemyKing, occupied) & diagonals);
+		}
+		case Move::Flag::CASTLE: {
+			// Only the rook can give check, on the occupancy after both pieces have moved
+			Square rookFrom = rCastleFrom(from, to);
+			Square rookTo = rCastleTo(from, to);
+			occupied = (occupied ^ (1ULL << rookFrom)) | toBB | (1ULL << rookTo);
+			return getMovementBoard<ROOK>(rookTo, occupied) & (1ULL << enemyKing);
+		}
+		case Move::Flag::QUEEN:
+			return getMovementBoard<QUEEN>(to, occupied) & (1ULL << enemyKing);
+		case Move::Flag::ROOK:
+			return getMovementBoard<ROOK>(to, occupied) & (1ULL << enemyKing);
+		case Move::Flag::BISHOP:
+			return getMovementBoard<BISHOP>(to, occupied) & (1ULL << enemyKing);
+		case Move::Flag::KNIGHT:
+			return getMovementBoard<KNIGHT>(to, occupied) & (1ULL << enemyKing);
+		default:
+			return false;
+		}
+	}
+
+	// Returns whether a move is pseudo legal in the current position, without generating moves.
+	// Used to validate moves which may come from another position, such as transposition table
+	// entries after a hash collision, or killer moves from a sibling node
+	bool Board::isPseudoLegal(Move move) const {
+		Color us = mSideToMove;
+		Square from = move.from();
+		Square to = move.to();
+		Move::Flag flag = move.flag();
+		Piece piece = squares[from];
+		Bitboard toBB = 1ULL << to;
+		Bitboard occupied = typesBB[ALL_PIECES];
+
+		// Flags outside the encoded range, including the promotion bits of an unflagged move, are never generated
+		if (from == to || flag < Move::Flag::KNIGHT || flag > Move::Flag::NO_FLAG || piece == NO_PIECE || colorOf(piece) != us
+			|| (colorsBB[us] & toBB) || typeOf(squares[to]) == KING) {
+			return false;
+		}
+
+		PieceType type = typeOf(piece);
+
+		if (type == PAWN) {
+			Direction up = pawnPush(us);
+			Bitboard attacks = us == WHITE ? getPawnAttackMoves<WHITE>(from) : getPawnAttackMoves<BLACK>(from);
+
+			if (flag == Move::Flag::EN_PASSANT) {
+				return to == state->enPassantSquare && (attacks & toBB);
+			}
+
+			// Moves from the row before promotion must promote, and no others may
+			bool promotes = toRow(from) == (us == WHITE ? ROW_7 : ROW_2);
+			if (promotes != move.isPromotion()) {
+				return false;
+			}
+
+			if (flag == Move::Flag::PAWN_TWO_SQUARES) {
+				return toRow(from) == (us == WHITE ? ROW_2 : ROW_7) && to == from + 2 * up
+					&& !(occupied & ((1ULL << (from + up)) | toBB));
+			}
+
+			if (flag == Move::Flag::CASTLE) {
+				return false;
+			}
+
+			if (to == from + up) {
+				return !(occupied & toBB);
+			}
+
+			return attacks & colorsBB[~us] & toBB;
+		}
+
+		if (flag == Move::Flag::CASTLE) {
+			if (type != KING) {
+				return false;
+			}
+			if (to == from + 2 * EAST) {
+				return canShortCastle(us, state->cr) && !(emptyShortCastleSQ[us] & occupied);
+			}
+			if (to == from + 2 * WEST) {
+				return canLongCastle(us, state->cr) && !(emptyLongCastleSQ[us] & occupied);
+			}
+			return false;
+		}
+
+		if (flag != Move::Flag::NO_FLAG) {
+			return false;
+		}
+
+		switch (type) {
+		case KNIGHT:
+			return getMovementBoard<KNIGHT>(from, occupied) & toBB;
+		case BISHOP:
+			return getMovementBoard<BISHOP>(from, occupied) & toBB;
+		case ROOK:
+			return getMovementBoard<ROOK>(from, occupied) & toBB;
+		case QUEEN:
+			return getMovementBoard<QUEEN>(from, occupied) & toBB;
+		case KING:
+			return getMovementBoard<KING>(from, occupied) & toBB;
+		default:
+			return false;
+		}
+	}
+
 	void Board::movePiece(Square from, Square to) {
 		Piece piece = squares[from];
 		
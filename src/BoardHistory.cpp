@@ -1,5 +1,6 @@
 #include "BoardHistory.h"
 
+#include <algorithm>
 #include <iostream>
 
 using namespace std;
@@ -13,11 +14,36 @@ namespace SandalBot {
 		startSearchIndicies[0] = 0;
 	}
 
+	BoardHistory::BoardHistory(const BoardHistory& other)
+		: historySize(other.historySize), numBoards(other.numBoards) {
+		hashHistory = new HashKey[historySize];
+		startSearchIndicies = new int[historySize + 1];
+
+		std::copy(other.hashHistory, other.hashHistory + numBoards, hashHistory);
+		std::copy(other.startSearchIndicies, other.startSearchIndicies + numBoards + 1, startSearchIndicies);
+	}
+
 	BoardHistory::~BoardHistory() {
 		delete[] hashHistory;
 		delete[] startSearchIndicies;
 	}
 
+	BoardHistory& BoardHistory::operator=(const BoardHistory& other) {
+		if (this != &other) {
+			if (historySize != other.historySize) {
+				delete[] hashHistory;
+				delete[] startSearchIndicies;
+				historySize = other.historySize;
+				hashHistory = new HashKey[historySize];
+				startSearchIndicies = new int[historySize + 1];
+			}
+			numBoards = other.numBoards;
+			std::copy(other.hashHistory, other.hashHistory + numBoards, hashHistory);
+			std::copy(other.startSearchIndicies, other.startSearchIndicies + numBoards + 1, startSearchIndicies);
+		}
+		return *this;
+	}
+
 	// Standard push function which adds new hash and start indice.
 	// Also dynamically adjusts size of arrays if needed
 	void BoardHistory::push(HashKey value, bool reset) {
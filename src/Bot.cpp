@@ -1,9 +1,11 @@
 #include "Bot.h"
 
+#include "FEN.h"
 #include "Types.h"
 
-#include <cmath>
-#include <iostream>
+#include <algorithm>
+#include <cstdlib>
+#include <sstream>
 #include <stdexcept>
 #include <string>
 
@@ -11,64 +13,37 @@ using namespace std;
 
 namespace SandalBot {
 
-    // Validates a move on the current board position
-    int Bot::validateUserMove(MovePoint moves[218], Square from, Square to, Move::Flag flag) {
-        // Generate all possible moves in position
-        int numMoves = searcher->moveGenerator.generate(moves);
-        int moveIndex = -1;
-        // If proposed move is in possible moves, it is a valid move
-        for (int i = 0; i < numMoves; i++) {
-            if (moves[i].move.from() == from && moves[i].move.to() == to &&
-                (moves[i].move.flag() > Move::Flag::QUEEN || moves[i].move.flag() == flag)) {
-                moveIndex = i;
-                break;
-            }
-        }
-
-        return moveIndex;
-    }
-
-    Bot::Bot() {
-        board = new Board();
-        searcher = new Searcher(board);
-    }
-
-    Bot::~Bot() {
-        delete board;
-        delete searcher;
-    }
-
-    // Set new board position
-    void Bot::setPosition(std::string_view FEN) {
-        board->loadPosition(FEN);
-    }
-
-    // Make a move from provided string. String must be in pure algebraic coordinate notation (per UCI)
-    void Bot::makeMove(std::string movestr) {
+    // Converts a move in pure algebraic coordinate notation to a move on the current position, the
+    // flag follows from the moving piece. Returns a null move unless the move is legal, which is
+    // checked without generating every move of the position
+    Move Bot::parseUserMove(const std::string& movestr) {
         // UCI notation does not permit moves with length outside [3, 5]
         if (movestr.size() < 3 || movestr.size() > 5) {
-            return;
+            return Move();
         }
         // These variables define all moves
         Square from;
         Square to;
-        Move::Flag flag;
+        Move::Flag flag = Move::Flag::NO_FLAG;
 
         // Castle notation are edge cases
-        if (movestr == "O-O") {
-            from = Square(board->sideToMove() == WHITE ? W_KING_SQUARE : B_KING_SQUARE);
-            to = board->sideToMove() == WHITE ? G1 : G8;
-            flag = Move::Flag::CASTLE;
-        } else if (movestr == "O-O-O") {
-            from = Square(board->sideToMove() == WHITE ? W_KING_SQUARE : B_KING_SQUARE);
-            to = board->sideToMove() == WHITE ? C1 : C8;
+        if (movestr == "O-O" || movestr == "O-O-O") {
+            from = board->kingSquares[board->sideToMove()];
+            to = Square(from + (movestr == "O-O" ? 2 * EAST : 2 * WEST));
             flag = Move::Flag::CASTLE;
         } else {
-            // Extract start and target square
+            if (movestr.size() < 4) {
+                return Move();
+            }
+            // Extract start and target square, either is -1 if its file or rank is off the board
             from = Square(CoordHelper::stringToIndex(movestr.substr(0, 2)));
             to = Square(CoordHelper::stringToIndex(movestr.substr(2, 2)));
-            flag = Move::Flag::NO_FLAG;
+            if (from < START_SQUARE || from >= SQUARES_NB || to < START_SQUARE || to >= SQUARES_NB) {
+                return Move();
+            }
 
+            PieceType type = typeOf(board->squares[from]);
+            int distance = abs(int(to) - int(from));
             // Promotion moves have an extra character for promotion piece
             if (movestr.size() == 5) {
                 switch (movestr[4]) {
@@ -84,57 +59,173 @@ namespace SandalBot {
                 case 'b':
                     flag = Move::Flag::BISHOP;
                     break;
+                default:
+                    return Move();
                 }
+            } else if (type == KING && distance == 2) {
+                flag = Move::Flag::CASTLE;
+            } else if (type == PAWN && distance == 16) {
+                flag = Move::Flag::PAWN_TWO_SQUARES;
+            } else if (type == PAWN && toCol(from) != toCol(to) && board->squares[to] == NO_PIECE) {
+                flag = Move::Flag::EN_PASSANT;
             }
         }
 
-        // Validate move
-        MovePoint positionMoves[218];
-        int moveIndex = validateUserMove(positionMoves, from, to, flag);
+        Move move(from, to, flag);
+        if (!board->isPseudoLegal(move) || !board->isLegal(move)) {
+            return Move();
+        }
+        return move;
+    }
+
+    Bot::Bot() {
+        board = new Board();
+        searcher = new Searcher(board);
+        perftRunner = new Perft(board);
+    }
+
+    // Searches with the given transposition table, which may be shared with other bots
+    Bot::Bot(std::shared_ptr<TranspositionTable> table) {
+        board = new Board();
+        searcher = new Searcher(board, std::move(table));
+        perftRunner = new Perft(board);
+    }
+
+    Bot::~Bot() {
+        delete board;
+        delete searcher;
+        delete perftRunner;
+    }
+
+    // Sets the listener receiving search results, best moves and perft counts
+    void Bot::setListener(SearchListener* listener) {
+        this->listener = listener;
+        searcher->setListener(listener);
+    }
+
+    // Forget everything learnt in the previous game, options are kept. A table shared with other
+    // bots may be kept, as clearing it would clear it for them as well
+    void Bot::newGame(bool clearHash) {
+        if (clearHash) {
+            searcher->clearHash();
+        }
+        searcher->orderer = MoveOrderer();
+        board->loadPosition(FEN::startpos);
+        positionFEN.clear();
+    }
+
+    // Set new board position and play the moves on it. GUIs resend the whole game before every
+    // search, so when the position is the last one set followed by new moves, only those are played.
+    // Returns whether every played move was legal
+    bool Bot::setPosition(std::string_view FEN, const vector<string>& moves) {
+        bool extendsPosition = !positionFEN.empty() && FEN == positionFEN && moves.size() >= positionMoves.size()
+            && equal(positionMoves.begin(), positionMoves.end(), moves.begin());
+
+        if (!extendsPosition) {
+            board->loadPosition(FEN);
+            positionFEN = FEN;
+            positionMoves.clear();
+        }
 
-        if (moveIndex == -1) 
-            return;
+        // Illegal moves are skipped, but kept in the list so it still matches the next command
+        bool legal = true;
+        for (size_t i = positionMoves.size(); i < moves.size(); i++) {
+            Move move = parseUserMove(moves[i]);
+            if (move != Move()) {
+                board->makeMove(move);
+            } else {
+                legal = false;
+            }
+            positionMoves.push_back(moves[i]);
+        }
+        return legal;
+    }
 
-        // If move is valid, enact move
-        board->makeMove(positionMoves[moveIndex].move);
+    // Sets the depth, node, mate and root move limits of the following searches, zero or empty
+    // is no limit. Search moves which are not legal in the position are ignored
+    void Bot::setSearchLimits(int depth, uint64_t nodes, int mate, const vector<string>& searchMoves) {
+        Searcher::SearchLimits limits{ depth, nodes, mate };
+        for (const string& movestr : searchMoves) {
+            Move move = parseUserMove(movestr);
+            if (move != Move()) {
+                limits.searchMoves.push_back(move);
+            }
+        }
+        searcher->setLimits(limits);
+    }
+
+    // Make a move from provided string. String must be in pure algebraic coordinate notation (per UCI).
+    // Returns false, leaving the position unchanged, if the move is not legal
+    bool Bot::makeMove(std::string movestr) {
+        Move move = parseUserMove(movestr);
+        if (move == Move()) {
+            return false;
+        }
+
+        board->makeMove(move);
+        positionFEN.clear();
+        return true;
+    }
+
+    // FEN string of the current position
+    string Bot::fen() const {
+        return FEN::generateFEN(board);
     }
 
     // Generate move within allotted time in milliseconds
     string Bot::generateMove(int moveTimeMs) {
         searcher->startSearch(true, moveTimeMs); // Generate move
 
+        return reportBestMove();
+    }
+
+    // Generate move with time allotted from the clock of the side to move, a movesToGo of zero
+    // means the remaining time is for the rest of the game
+    string Bot::generateMove(int whiteTimeMs, int blackTimeMs, int whiteIncMs, int blackIncMs, int movesToGo) {
+        int timeMs = board->sideToMove() == WHITE ? whiteTimeMs : blackTimeMs;
+        int incMs = board->sideToMove() == WHITE ? whiteIncMs : blackIncMs;
+
+        searcher->startClockSearch(timeMs, incMs, movesToGo); // Generate move
+
+        return reportBestMove();
+    }
+
+    // Reports the best move found by the last search to the listener, with the expected reply to
+    // ponder on when the principal variation has one, and returns its squares
+    string Bot::reportBestMove() {
         // If move is essentially null, either error, illegal position, or could not find move in time frame
         if (searcher->bestMove == Move()) {
             return "";
         }
 
-        // Generate UCI notation from generated move
-        string from = CoordHelper::indexToString(searcher->bestMove.from());
-        string to = CoordHelper::indexToString(searcher->bestMove.to());
-        string flag = "";
-
-        switch (searcher->bestMove.flag()) {
-        case Move::Flag::QUEEN:
-            flag = "q";
-            break;
-        case Move::Flag::BISHOP:
-            flag = "b";
-            break;
-        case Move::Flag::KNIGHT:
-            flag = "n";
-            break;
-        case Move::Flag::ROOK:
-            flag = "r";
-            break;
+        if (listener != nullptr) {
+            listener->onBestMove(searcher->bestMove, searcher->ponderMove());
         }
 
-        cout << "bestmove " << from << to << flag << endl;
-        return from + to;
+        return CoordHelper::indexToString(searcher->bestMove.from()) + CoordHelper::indexToString(searcher->bestMove.to());
     }
 
-    // Search position asynchronously
+    // Search position until stopped, or until a depth, node or mate limit is reached, then report
+    // the best move
     void Bot::go() {
         searcher->startSearch(false);
+        reportBestMove();
+    }
+
+    // Search the position after the expected reply until ponderhit or stop, then report the best
+    // move. Time is allotted from the clock of the side to move once ponderhit arrives
+    string Bot::ponder(int whiteTimeMs, int blackTimeMs, int whiteIncMs, int blackIncMs, int movesToGo, int moveTimeMs) {
+        int timeMs = board->sideToMove() == WHITE ? whiteTimeMs : blackTimeMs;
+        int incMs = board->sideToMove() == WHITE ? whiteIncMs : blackIncMs;
+
+        searcher->startPonderSearch(timeMs, incMs, movesToGo, moveTimeMs);
+
+        return reportBestMove();
+    }
+
+    // The opponent played the expected reply, continue the ponder search as a timed search
+    void Bot::ponderHit() {
+        searcher->ponderHit();
     }
 
     // Generate static evaluation from position
@@ -142,6 +233,11 @@ namespace SandalBot {
         return searcher->eval();
     }
 
+    // Readies the next search before it is posted to another thread, so a stop sent after posting is kept
+    void Bot::prepareSearch() {
+        searcher->prepareSearch();
+    }
+
     // End asynchronous search
     void Bot::stopSearching() {
         searcher->endSearch();
@@ -154,7 +250,22 @@ namespace SandalBot {
             return 1;
         }
 
-        uint64_t movesgenerated = searcher->perft(depth);
+        PerfCounters counters;
+        if (perfCounters) {
+            counters.start();
+        }
+
+        SearchListener discard;
+        uint64_t movesgenerated = perftRunner->divide(depth, listener != nullptr ? *listener : discard);
+
+        if (perfCounters) {
+            counters.stop();
+            if (listener != nullptr) {
+                ostringstream report;
+                counters.report(report, movesgenerated);
+                listener->onInfo(report.str());
+            }
+        }
 
         return movesgenerated;
     }
@@ -164,32 +275,56 @@ namespace SandalBot {
         board->printBoard();
     }
 
-    // Returns the amount of thinking time the bot wishes to spend while generating a move
-    int Bot::chooseMoveTime(int whiteTimeMs, int blackTimeMs, int whiteIncMs, int blackIncMs) {
-        int timeRemaining = board->sideToMove() == WHITE ? whiteTimeMs : blackTimeMs;
-        int incMs = board->sideToMove() == WHITE ? whiteIncMs : blackIncMs;
-        double minTimeMs = min(50, int(timeRemaining * 0.25));
-        double moveTimeMs = float(timeRemaining) / 40.0f;
+    // Change the size of the transposition table
+    void Bot::changeHashSize(int sizeMB) {
+        searcher->changeHashSize(sizeMB);
+    }
 
-        if (timeRemaining > incMs * 2 && moveTimeMs > 50) moveTimeMs += timeRemaining * 0.1;
+    // Clear the transposition table
+    void Bot::clearHash() {
+        searcher->clearHash();
+    }
 
-        if (timeRemaining > 45000) return maxMoveTime + static_cast<int>(0.5 * static_cast<double>(incMs));
+    // Change the margin used by lazy evaluation in quiescence search
+    void Bot::setLazyEvalMargin(int margin) {
+        searcher->setLazyEvalMargin(margin);
+    }
 
+    // Switch search and perft between legal and pseudo legal move generation
+    void Bot::setPseudoLegal(bool pseudoLegal) {
+        searcher->setPseudoLegal(pseudoLegal);
+        perftRunner->setPseudoLegal(pseudoLegal);
+    }
 
+    // Change the size of the perft hash table, zero disables hashing
+    void Bot::setPerftHashSize(int sizeMB) {
+        perftRunner->setHashSize(sizeMB);
+    }
 
-        int a = static_cast<int>(max(minTimeMs, moveTimeMs));
+    // Change the time reserved per move for communication delays
+    void Bot::setMoveOverhead(int overheadMs) {
+        searcher->setMoveOverhead(overheadMs);
+    }
 
-        return int(ceil(min(a, maxMoveTime)));
+    // Change the number of best moves searched and reported each iteration
+    void Bot::setMultiPV(int lines) {
+        searcher->setMultiPV(lines);
     }
 
-    // Change the size of the transposition table
-    void Bot::changeHashSize(int sizeMB) {
-        searcher->changeHashSize(sizeMB);
+    // Print search counters after each iteration
+    void Bot::setSearchStats(Searcher::StatsFormat format) {
+        searcher->setStatsFormat(format);
     }
 
-    // Clear the transposition table
-    void Bot::clearHash() {
-        searcher->clearHash();
+    // Report hardware performance counters after search, perft and bench
+    void Bot::setPerfCounters(bool enabled) {
+        perfCounters = enabled;
+        searcher->setPerfCounters(enabled);
+    }
+
+    // Change the number of threads perft splits its tree between, zero uses every hardware thread
+    void Bot::setPerftThreads(int threads) {
+        perftRunner->setThreads(threads);
     }
 
 }
\ No newline at end of file
@@ -0,0 +1,37 @@
+#include "BufferedWriter.h"
+
+using namespace std;
+
+namespace SandalBot {
+
+	void BufferedWriter::append(string_view text) {
+		lock_guard<std::mutex> lock{ mutex };
+		buffer += text;
+	}
+
+	void BufferedWriter::write(string_view text) {
+		lock_guard<std::mutex> lock{ mutex };
+		buffer += text;
+		flushBuffer();
+	}
+
+	void BufferedWriter::writeLine(string_view line) {
+		lock_guard<std::mutex> lock{ mutex };
+		buffer += line;
+		buffer += '\n';
+		flushBuffer();
+	}
+
+	void BufferedWriter::flush() {
+		lock_guard<std::mutex> lock{ mutex };
+		flushBuffer();
+	}
+
+	// Writes the buffer with one call, the mutex must be held
+	void BufferedWriter::flushBuffer() {
+		out.write(buffer.data(), streamsize(buffer.size()));
+		out.flush();
+		buffer.clear();
+	}
+
+}
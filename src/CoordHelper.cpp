@@ -45,7 +45,9 @@ namespace SandalBot {
             std::string coord = std::string(1, charFiles[col]) + std::string(1, charRanks[row]);
             return coord;
         }
-        // Converts human-readable coordinate to an index on a linear board
+        // Converts human-readable coordinate to an index on a linear board, or -1 if the file or rank
+        // is off the board. These are checked on their own, as an off board file combined with a rank
+        // would wrap onto a square of the neighbouring rank
         int stringToIndex(std::string str) {
             if (str.size() != 2) {
                 throw std::length_error("Coordinate incorrect size: " + str.size());
@@ -53,6 +55,9 @@ namespace SandalBot {
 
             int row = StringUtil::indexOf(charRanks, std::string(1, str[1]));
             int col = StringUtil::indexOf(charFiles, std::string(1, str[0]));
+            if (row == -1 || col == -1) {
+                return -1;
+            }
             return row * 8 + col;
         }
         // Returns row from index
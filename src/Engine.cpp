@@ -0,0 +1,159 @@
+#include "Engine.h"
+
+#include "Init.h"
+
+#include <algorithm>
+#include <utility>
+
+using namespace std;
+
+namespace SandalBot {
+
+	namespace {
+
+		// Table an engine searches with. Globals are initialised here, as they must be before the
+		// engine's board is created
+		shared_ptr<TranspositionTable> engineTable(const EngineOptions& options) {
+			initGlobals();
+			return options.sharedTable ? options.sharedTable : Engine::createTable(options.hashSizeMB);
+		}
+
+	}
+
+	Engine::Engine(const EngineOptions& options) : sharedTable(options.sharedTable != nullptr), bot(engineTable(options)) {
+		bot.setListener(&collector);
+	}
+
+	// Stops and waits for any asynchronous search, whose callback is still run
+	Engine::~Engine() {
+		stop();
+		wait();
+	}
+
+	// Creates a transposition table of sizeMB, at least one, which engines given it in their options share
+	shared_ptr<TranspositionTable> Engine::createTable(int sizeMB) {
+		return make_shared<TranspositionTable>(max(sizeMB, 1));
+	}
+
+	// Sets the position from a FEN string followed by moves in UCI notation. Returns whether every
+	// move was legal, illegal moves are skipped. Throws on an invalid FEN string
+	bool Engine::setPosition(string_view fen, const vector<string>& moves) {
+		wait();
+		return bot.setPosition(fen, moves);
+	}
+
+	// Plays a move in UCI notation, returns false if it is not legal
+	bool Engine::makeMove(const string& move) {
+		wait();
+		return bot.makeMove(move);
+	}
+
+	string Engine::fen() {
+		wait();
+		return bot.fen();
+	}
+
+	// Returns to the start position and forgets the previous game. A shared table is kept, as other
+	// engines may be using it
+	void Engine::newGame() {
+		wait();
+		bot.newGame(!sharedTable);
+	}
+
+	// Sets the listener receiving search events as they happen, none only reports results
+	void Engine::setListener(SearchListener* listener) {
+		wait();
+		collector.listener = listener;
+	}
+
+	// Searches the position on the calling thread
+	SearchResult Engine::search(const SearchRequest& request) {
+		wait();
+		bot.prepareSearch();
+		return run(request);
+	}
+
+	// Searches the position on the engine's search thread, which calls onComplete with the result.
+	// The search is readied before it is posted, so a stop sent once this returns always ends it
+	void Engine::searchAsync(const SearchRequest& request, Callback onComplete) {
+		if (!searchThread) {
+			searchThread = make_unique<SearchThread>();
+		}
+		wait();
+		bot.prepareSearch();
+		searchThread->start([this, request, onComplete = std::move(onComplete)] {
+			SearchResult result = run(request);
+			if (onComplete) {
+				onComplete(result);
+			}
+		});
+	}
+
+	// Ends the running or starting search, which reports the best move found so far. Callable
+	// from any thread
+	void Engine::stop() {
+		bot.stopSearching();
+	}
+
+	// Blocks until an asynchronous search has ended and its callback returned
+	void Engine::wait() {
+		if (searchThread) {
+			searchThread->wait();
+		}
+	}
+
+	bool Engine::searching() {
+		return searchThread && searchThread->searching();
+	}
+
+	SearchResult Engine::run(const SearchRequest& request) {
+		collector.result = SearchResult();
+		bot.setSearchLimits(request.depth, request.nodes, request.mate, request.searchMoves);
+		bot.setMultiPV(request.multiPV);
+
+		if (request.moveTimeMs > 0) {
+			bot.generateMove(request.moveTimeMs);
+		} else {
+			bot.go();
+		}
+
+		collector.result.nodes = bot.nodes();
+		return collector.result;
+	}
+
+	void Engine::ResultCollector::onIteration(const IterationReport& report) {
+		result.depth = report.depth;
+		result.lines = report.lines;
+		result.eval = report.lines.empty() ? 0 : report.lines[0].eval;
+		if (listener != nullptr) {
+			listener->onIteration(report);
+		}
+	}
+
+	void Engine::ResultCollector::onCurrentMove(int depth, Move move, int moveNumber, uint64_t timeMs) {
+		if (listener != nullptr) {
+			listener->onCurrentMove(depth, move, moveNumber, timeMs);
+		}
+	}
+
+	void Engine::ResultCollector::onBestMove(Move move, Move ponder) {
+		result.bestMove = move;
+		result.ponderMove = ponder;
+		if (listener != nullptr) {
+			listener->onBestMove(move, ponder);
+		}
+	}
+
+	void Engine::ResultCollector::onPerftMove(Move move, uint64_t nodes) {
+		if (listener != nullptr) {
+			listener->onPerftMove(move, nodes);
+		}
+	}
+
+	void Engine::ResultCollector::onInfo(string_view text) {
+		if (listener != nullptr) {
+			listener->onInfo(text);
+		}
+	}
+
+}
@@ -75,13 +75,76 @@ namespace SandalBot {
 
 		calculateEndgameWeight();
 
-		int evaluation{ 0 };
+		// If insufficient material its a draw
+		if (insufficientMaterial()) {
+			return drawScore;
+		}
+
+		return fullEvaluation();
+	}
+
+	// Window aware evaluation. Computes the incrementally updated material and piece square values
+	// first, and if they lie outside (alpha, beta) by more than lazyMargin the remaining terms cannot
+	// bring the score back inside the window, so the cheap score is returned
+	int Evaluator::Evaluate(Board* board, int alpha, int beta) {
+		assert(board != nullptr);
+		this->board = board;
+
+		calculateEndgameWeight();
 
 		// If insufficient material its a draw
 		if (insufficientMaterial()) {
 			return drawScore;
 		}
 
+		lazyProbes++;
+
+		int lazyEvaluation = board->sideValues[WHITE] + board->pieceSquareValues[WHITE]
+			- board->sideValues[BLACK] - board->pieceSquareValues[BLACK];
+		lazyEvaluation = board->sideToMove() ? lazyEvaluation : -lazyEvaluation;
+
+		// Compare without subtracting from bounds, since alpha and beta may be at integer limits
+		if (lazyEvaluation - lazyMargin >= beta || lazyEvaluation + lazyMargin <= alpha) {
+			lazyExits++;
+			return lazyEvaluation;
+		}
+
+		return fullEvaluation();
+	}
+
+	// Returns a single evaluation term from white's perspective
+	int Evaluator::evaluateTerm(Board* board, Term term) {
+		assert(board != nullptr);
+		this->board = board;
+
+		calculateEndgameWeight();
+
+		switch (term) {
+		case STATIC_PIECES:
+			return staticPieceEvaluation<WHITE>() - staticPieceEvaluation<BLACK>();
+		case PAWN_ISLANDS:
+			return pawnIslandEvaluation<WHITE>() - pawnIslandEvaluation<BLACK>();
+		case PASSED_PAWNS:
+			return passedPawnEvaluation<WHITE>() - passedPawnEvaluation<BLACK>();
+		case KING_SAFETY:
+			return kingSafety<WHITE>() - kingSafety<BLACK>();
+		case MOBILITY:
+			return mobilityEvaluation<WHITE>() - mobilityEvaluation<BLACK>();
+		case THREATS:
+			return threatEvaluation<WHITE>() - threatEvaluation<BLACK>();
+		case OPEN_FILES:
+			return openFilesEvaluation();
+		case OPEN_DIAGONALS:
+			return openDiagEvaluation();
+		default:
+			return 0;
+		}
+	}
+
+	// Sums every evaluation term, from the perspective of the side to move
+	int Evaluator::fullEvaluation() {
+		int evaluation{ 0 };
+
 		evaluation += evaluateSide<WHITE>();
 		evaluation -= evaluateSide<BLACK>();
 
@@ -101,6 +164,8 @@ namespace SandalBot {
 		evaluation += pawnIslandEvaluation<Us>();
 		evaluation += passedPawnEvaluation<Us>();
 		evaluation += kingSafety<Us>();
+		evaluation += mobilityEvaluation<Us>();
+		evaluation += threatEvaluation<Us>();
 
 		return evaluation;
 	}
@@ -132,7 +197,7 @@ namespace SandalBot {
 
 		evaluation = evaluation * kingSafetyCoefficient;
 
-		//evaluation += kingAttackZone<Us>();
+		evaluation += kingAttackZone<Us>();
 
 		return evaluation;
 	}
@@ -258,75 +323,53 @@ namespace SandalBot {
 		return evaluation;
 	}
 
-	// Returns evaluation of king safety from an attack zone
+	// Returns evaluation of king safety from the opponent's attacks on the zone around the king
 	template <Color Us>
 	int Evaluator::kingAttackZone() {
-		Bitboard usPieces = board->colorsBB[Us];
+		const AttackInfo& attackInfo = board->attacks(true);
 		Square usKSq = board->kingSquares[Us];
 		
-		Bitboard attackZone = (abs(toRow(usKSq) - startRow[WHITE]) >= 2 || endGameWeight >= 0.2f)
+		Bitboard attackZone = (abs(toRow(usKSq) - startRow[Us]) >= 2 || endGameWeight >= 0.2f)
 			? getUnbiasKingAttackZone(usKSq) : getKingAttackSquare<Us>(usKSq);
 
-		int evaluation = 0;
-
-		Bitboard knights = usPieces & board->typesBB[KNIGHT];
-		Bitboard pawns = usPieces & board->typesBB[PAWN];
-		Bitboard rooks = usPieces & board->typesBB[ROOK];
-		Bitboard bishops = usPieces & board->typesBB[BISHOP];
-		Bitboard queens = rooks & bishops;
-
-		// Sum number of moves in king attack zone multiplied by piece weightings
-		evaluation += evalMoves<Us, QUEEN>(attackZone);
-		evaluation += evalMoves<Us, ROOK>(attackZone);
-		evaluation += evalMoves<Us, BISHOP>(attackZone);
-		evaluation += evalMoves<Us, KNIGHT>(attackZone);
-		evaluation += evalPawnMoves<Us>(attackZone);
+		float attackUnits = 0.f;
 
-		evaluation = -kingZoneSafety[evaluation];
-
-		return evaluation;
-	}
-
-	int Evaluator::incrementAttackZoneEval(Bitboard attackZone, Bitboard moves, PieceType piece) {
-		Bitboard zoneMoves = attackZone & moves;
-		int evaluation = 0;
-
-		while (zoneMoves != 0ULL) {
-			popLSB(zoneMoves);
-			evaluation += attackUnitScores[piece];
+		// Sum number of attacked squares in king attack zone multiplied by piece weightings
+		for (PieceType type = PAWN; type < KING; ++type) {
+			attackUnits += popCount(attackInfo.attacks[~Us][type] & attackZone) * attackUnitScores[type];
 		}
 
-		return evaluation;
-	}
+		int evaluation = -kingZoneSafety[std::min(int(attackUnits), 99)];
 
-	template <Color Us, PieceType Type>
-	int Evaluator::evalMoves(Bitboard attackZone) {
-		Bitboard pieces = board->typesBB[Type] & board->colorsBB[Us];
-		Square themKSq = board->kingSquares[~Us];
-		Bitboard allPieces = board->typesBB[ALL_PIECES];
-		allPieces &= ~(1ULL << themKSq);
+		return evaluation * (1.f - endGameWeight);
+	}
 
+	// Returns evaluation of the number of safe squares each piece type can move to
+	template <Color Us>
+	int Evaluator::mobilityEvaluation() {
+		const AttackInfo& attackInfo = board->attacks(true);
+		// Squares which are not occupied by own pieces or attacked by enemy pawns
+		Bitboard safeSquares = ~board->colorsBB[Us] & ~attackInfo.attacks[~Us][PAWN];
 		int evaluation = 0;
 
-		while (pieces != 0ULL) {
-			Square from = popLSB(pieces);
-			Bitboard movementBB = getMovementBoard<Type>(from, allPieces);
-			evaluation += incrementAttackZoneEval(attackZone, movementBB, Type);
+		for (PieceType type = KNIGHT; type < KING; ++type) {
+			evaluation += popCount(attackInfo.attacks[Us][type] & safeSquares) * mobilityWeightings[type];
 		}
 
 		return evaluation;
 	}
 
+	// Returns evaluation of enemy pieces attacked by pawns, and attacked enemy pieces which are undefended
 	template <Color Us>
-	int Evaluator::evalPawnMoves(Bitboard attackZone) {
-		Bitboard pawns = board->typesBB[PAWN] & board->colorsBB[Us];
+	int Evaluator::threatEvaluation() {
+		const AttackInfo& attackInfo = board->attacks(true);
+		Bitboard enemyPieces = board->colorsBB[~Us] & ~board->typesBB[KING];
 		int evaluation = 0;
 
-		while (pawns != 0ULL) {
-			Square from = popLSB(pawns);
-			Bitboard movementBB = getPawnAttackMoves<~Us>(from);
-			evaluation += incrementAttackZoneEval(attackZone, movementBB, PAWN);
-		}
+		evaluation += popCount(attackInfo.attacks[Us][PAWN] & enemyPieces & ~board->typesBB[PAWN]) * pawnThreatBonus;
+
+		Bitboard hangingPieces = enemyPieces & attackInfo.attacks[Us][ALL_PIECES] & ~attackInfo.attacks[~Us][ALL_PIECES];
+		evaluation += popCount(hangingPieces) * hangingPieceBonus;
 
 		return evaluation;
 	}
@@ -426,7 +469,8 @@ namespace SandalBot {
 
 		return evaluation;
 	}
-	// Returns evaluation of open diagonals
+	// Returns evaluation of open diagonals. Pawns are counted on fixed diagonal masks, so there are no
+	// per-slider attack lookups for Kogge-Stone fills to replace
 	int Evaluator::openDiagEvaluation() {
 		// Endgame is less likely to require open diags
 		if (endGameWeight >= 0.3)
@@ -179,7 +179,8 @@ namespace SandalBot {
 		// If en passant target square is of length two (e.g. 'e3') it is available
 		if (sections.size() > 3 && sections[3].size() == 2) {
 			std::string enPassantSquareName = sections[3];
-			newInfo.enPassantSquare = Square(CoordHelper::stringToIndex(enPassantSquareName));
+			int enPassantIndex = CoordHelper::stringToIndex(enPassantSquareName);
+			newInfo.enPassantSquare = enPassantIndex == -1 ? NONE_SQUARE : Square(enPassantIndex);
 		}
 		// fifty move counter
 		if (sections.size() > 4) {
@@ -4,9 +4,13 @@
 #include <cctype>
 #include <chrono>
 #include <fstream>
+#include <functional>
 #include <iostream>
+#include <sstream>
 #include <stdexcept>
 #include <string>
+#include <thread>
+#include <utility>
 #include <vector>
 
 using namespace std;
@@ -15,7 +19,7 @@ using namespace chrono;
 namespace SandalBot {
 	// Opening message presented to user
 	void IUCI::beginningMessage() {
-		cout << name << " by " << author << "." << endl;
+		respond(string(name) + " by " + author + ".");
 	}
 	// Clears log file
 	void IUCI::emptyLogs() {
@@ -33,24 +37,97 @@ namespace SandalBot {
 		beginningMessage();
 
 		bot = new Bot();
+		bot->setListener(&listener);
 		optionHandler = new OptionHandler(bot);
 	}
 
 	IUCI::~IUCI() {
+		stop();
+		searchThread.wait(); // Bench and perft are not stopped
 		delete bot;
 		delete optionHandler;
 	}
+	// Processes commands from the input stream until quit or the end of input. A separate thread
+	// reads the input, so stop and isready are answered while other commands wait for a search
+	void IUCI::loop(istream& in) {
+		thread reader(&IUCI::readInput, this, ref(in));
+
+		while (!quitting) {
+			string command;
+			{
+				unique_lock<mutex> lock{ inputMutex };
+				inputReady.wait(lock, [this] { return !inputQueue.empty(); });
+				command = inputQueue.front();
+				inputQueue.pop_front();
+				processing = true;
+			}
+
+			processCommand(command);
+
+			lock_guard<mutex> lock{ inputMutex };
+			processing = false;
+		}
+
+		reader.join();
+	}
+	// Reads commands until quit or the end of input, which is treated as quit. Stop, ponderhit and
+	// isready are processed at once unless they follow commands which have not started yet, e.g. stop
+	// following a go which is still being parsed, in which case they are queued behind them
+	void IUCI::readInput(istream& in) {
+		string command;
+		while (getline(in, command)) {
+			vector<string> words = StringUtil::splitString(StringUtil::trim(command));
+			string commandType = words.empty() ? "" : StringUtil::toLower(words[0]);
+			bool immediate = commandType == "stop" || commandType == "isready" || commandType == "ponderhit";
+
+			{
+				lock_guard<mutex> lock{ inputMutex };
+				immediate = immediate && inputQueue.empty() && (!processing || searchThread.searching());
+				if (!immediate) {
+					inputQueue.push_back(command);
+					inputReady.notify_one();
+				}
+			}
+			if (immediate) {
+				processCommand(command);
+			}
+
+			if (commandType == "quit") {
+				return;
+			}
+		}
+
+		lock_guard<mutex> lock{ inputMutex };
+		inputQueue.push_back("quit");
+		inputReady.notify_one();
+	}
 	// Processes command string and parses it.
 	void IUCI::processCommand(string command) {
 		try {
 			command = StringUtil::trim(command); // Strip leading and end spaces
 			//Acquire first word
 			const string commandType = StringUtil::toLower(StringUtil::splitString(command)[0]);
+			// Commands answered while searching
+			if (commandType == "isready") {
+				respond("readyok");
+				return;
+			} else if (commandType == "stop") {
+				stop();
+				return;
+			} else if (commandType == "ponderhit") {
+				ponderHit();
+				return;
+			} else if (commandType == "quit") {
+				quit();
+				return;
+			}
+			// Other commands use the board, so wait for a timed search to finish
+			if (!awaitSearch()) {
+				return;
+			}
 			// Parse different commands
 			if (commandType == "uci") {
 				UCIok();
-			} else if (commandType == "isready") {
-				respond("readyok");
 			} else if (commandType == "ucinewgame") {
 				newGame();
 			} else if (commandType == "position") {
@@ -59,10 +136,8 @@ namespace SandalBot {
 				processGoCommand(command);
 			} else if (commandType == "eval") {
 				eval();
-			} else if (commandType == "stop") {
-				stop();
-			} else if (commandType == "quit") {
-				quit();
+			} else if (commandType == "bench") {
+				bench(command);
 			} else if (commandType == "setoption") {
 				processSetOption(command);
 			} else if (commandType == "d") {
@@ -72,39 +147,53 @@ namespace SandalBot {
 
 		}
 	}
-	// 'ucinewgame' command, deletes bot and instantiates new one
+	// 'ucinewgame' command, clears what the bot learnt in the previous game
 	void IUCI::newGame() {
 		stop();
-		delete bot;
-		bot = new Bot();
+		bot->newGame();
 	}
-	// Stops any current searching of the bot
+	// Stops any current searching of the bot, and waits until the search thread is parked. Bench
+	// and perft run to completion, so stop leaves them running rather than blocking until they end
 	void IUCI::stop() {
-		// If thread is running
-		if (goThread.joinable()) {
+		if (searchThread.searching() && stoppable) {
 			bot->stopSearching();
-			this_thread::sleep_for(chrono::milliseconds(100));
-			goThread.join();
-			this_thread::sleep_for(chrono::milliseconds(100));
+			searchThread.wait();
+		}
+		infiniteSearch = false;
+		pondering = false;
+	}
+	// 'ponderhit' command, the opponent played the expected reply so the ponder search continues
+	// as a timed search, which later commands wait for
+	void IUCI::ponderHit() {
+		if (pondering.exchange(false)) {
+			infiniteSearch = false;
+			bot->ponderHit();
 		}
 	}
-	// Quit command stops go thread and exits program
+	// Quit command finishes a timed search, stops an infinite search, and ends the command loop
 	void IUCI::quit() {
-		// Stop go thread
-		if (goThread.joinable()) {
-			bot->stopSearching();
-			goThread.join();
+		if (!awaitSearch()) {
+			stop();
 		}
-		// Exit
-		exit(0);
+		quitting = true;
+	}
+	// Waits for a timed search to finish. Returns false if an infinite search is running, which
+	// only finishes when stopped
+	bool IUCI::awaitSearch() {
+		if (infiniteSearch && searchThread.searching()) {
+			return false;
+		}
+		searchThread.wait();
+		infiniteSearch = false;
+		return true;
 	}
 	// Processes 'uci' command. Responds to user with available options
 	void IUCI::UCIok() {
 		respond(std::string("id name ") + name);
 		respond(std::string("id author ") + author);
-		cout << endl;
+		respond("");
 		respond(optionHandler->getOptionsString());
-		cout << endl;
+		respond("");
 		respond("uciok");
 	}
 	// Provides user with static evaluation of position
@@ -113,79 +202,150 @@ namespace SandalBot {
 
 		respond("evaluation " + to_string((float)evaluation / 100.f));
 	}
+	// 'bench [depth] [threads] [hash]' command, searches the bench positions to a fixed depth
+	// and reports the total node count as a signature of the search. Runs on the search thread,
+	// so isready is still answered, and its report is written in one piece once it ends
+	void IUCI::bench(string command) {
+		int values[3]{ Bench::defaultDepth, Bench::defaultThreads, Bench::defaultHashSizeMB };
+		vector<string> arguments = StringUtil::splitString(command);
+		for (size_t i = 1; i < arguments.size() && i <= 3; ++i) {
+			if (!StringUtil::isDigitString(arguments[i])) {
+				throw runtime_error("'" + arguments[i] + "' is not an integer.'");
+			}
+			values[i - 1] = stoi(arguments[i]);
+		}
+
+		bool perfCounters = bot->perfCountersEnabled();
+		stoppable = false;
+		post([this, values, perfCounters] {
+			ostringstream report;
+			Bench::run(values[0], values[1], values[2], report, perfCounters);
+			writer.write(report.str());
+		});
+	}
+	// Runs a job on the search thread. Exceptions thrown by it, such as a table too large to
+	// allocate, are reported as an info string, as they no longer reach processCommand
+	void IUCI::post(function<void()> job) {
+		searchThread.start([this, job = std::move(job)] {
+			try {
+				job();
+			} catch (const exception& e) {
+				listener.onInfo(string("error ") + e.what());
+			}
+		});
+	}
 	// Outputs best move
 	void IUCI::OnMoveChosen(string move) {
 		respond("bestmove " + move);
 	}
 	// Process go command into either, constant movetime search, perft test, infinite go search,
-	// or real time clock time search
+	// or real time clock time search. Depth, nodes, mate and searchmoves limit any search, and a
+	// search with no time limit ends by itself once it reaches a depth, node or mate limit. Searches
+	// run on the search thread, and arguments are parsed before they are posted so that parse errors
+	// are caught here
 	void IUCI::processGoCommand(string command) {
-		// If currently searching dont process command
-		if (goThread.joinable()) {
+		Bot* bot = this->bot;
+		// Extract values, increments, moves to go, move time and limits are optional
+		auto optionalValue = [&](string label) {
+			return StringUtil::contains(command, label) ? getLabelledValueInt(command, label, goLabels) : 0;
+		};
+
+		// Perft test, accepts user specified depth. Runs on the search thread to completion
+		if (StringUtil::contains(command, "perft")) {
+			int searchDepth = getLabelledValueInt(command, "perft", goLabels); // Extract depth
+			stoppable = false;
+			post([this, bot, searchDepth] {
+				auto start = high_resolution_clock::now(); // Time the search
+
+				uint64_t nodesSearched = bot->perft(searchDepth); // Get number of nodes
+
+				auto end = high_resolution_clock::now();
+				duration<double> duration = end - start;
+
+				listener.writePerft("Time taken: " + to_string(duration.count()) + "s, nodes per second: " + to_string(nodesSearched / duration.count())
+					+ "\nNodes searched: " + to_string(nodesSearched) + '\n');
+			});
 			return;
 		}
-		// Search position indefinitely, until stopped
-		if (command == "go" || StringUtil::contains(command, "infinite")) {
-			goThread = thread(&Bot::go, bot);
-		} 
-		// Search position for movetime milliseconds
-		else if (StringUtil::contains(command, "movetime")) {
-			int moveTimeMs = getLabelledValueInt(command, "movetime", goLabels); // Extract movetime number
-			bot->generateMove(moveTimeMs); // Search position
-		} 
-		// Perft test, accepts user specified depth
-		else if (StringUtil::contains(command, "perft")) {
-			int searchDepth = getLabelledValueInt(command, "perft", goLabels); // Extract depth
-			auto start = high_resolution_clock::now(); // Time the search
 
-			uint64_t nodesSearched = bot->perft(searchDepth); // Get number of nodes
+		int depth = optionalValue("depth");
+		int mate = optionalValue("mate");
+		// Node budgets may exceed the range of an int
+		uint64_t nodes = 0ULL;
+		if (StringUtil::contains(command, "nodes")) {
+			string nodesString = StringUtil::splitString(getLabelledValue(command, "nodes", goLabels))[0];
+			if (!StringUtil::isDigitString(nodesString)) {
+				throw runtime_error("'" + nodesString + "' is not an integer.'");
+			}
+			nodes = stoull(nodesString);
+		}
+		vector<string> searchMoves;
+		if (StringUtil::contains(command, "searchmoves")) {
+			searchMoves = StringUtil::splitString(getLabelledValue(command, "searchmoves", goLabels));
+		}
 
-			auto end = high_resolution_clock::now();
-			duration<double> duration = end - start;
+		int timeRemainingWhiteMs = optionalValue("wtime");
+		int timeRemainingBlackMs = optionalValue("btime");
+		int incrementWhiteMs = optionalValue("winc");
+		int incrementBlackMs = optionalValue("binc");
+		int movesToGo = optionalValue("movestogo");
+		int moveTimeMs = optionalValue("movetime");
 
-			respond("Time taken: " + to_string(duration.count()) + "s, nodes per second: " + to_string(nodesSearched / duration.count()));
-			respond("Nodes searched: " + to_string(nodesSearched));
-		} 
+		// Ready the search before posting it, so a stop which arrives before it starts is not lost
+		bot->prepareSearch();
+		stoppable = true;
+
+		// Search the expected position until ponderhit or stop, then with time from the clock or move time
+		if (StringUtil::contains(command, "ponder")) {
+			infiniteSearch = true;
+			pondering = true;
+			post([=] {
+				bot->setSearchLimits(depth, nodes, mate, searchMoves);
+				bot->ponder(timeRemainingWhiteMs, timeRemainingBlackMs, incrementWhiteMs, incrementBlackMs, movesToGo, moveTimeMs);
+			});
+		}
+		// Search position for movetime milliseconds
+		else if (StringUtil::contains(command, "movetime")) {
+			post([=] {
+				bot->setSearchLimits(depth, nodes, mate, searchMoves);
+				bot->generateMove(moveTimeMs); // Search position
+			});
+		}
 		// Use real time clocks and increments to generate a move
+		else if (StringUtil::contains(command, "wtime") || StringUtil::contains(command, "btime")) {
+			post([=] {
+				bot->setSearchLimits(depth, nodes, mate, searchMoves);
+				bot->generateMove(timeRemainingWhiteMs, timeRemainingBlackMs, incrementWhiteMs, incrementBlackMs, movesToGo);
+			});
+		}
+		// Search position until stopped, or until a depth, node or mate limit is reached
 		else {
-			// Extract values
-			int timeRemainingWhiteMs = getLabelledValueInt(command, "wtime", goLabels);
-			int timeRemainingBlackMs = getLabelledValueInt(command, "btime", goLabels);
-			int incrementWhiteMs = getLabelledValueInt(command, "winc", goLabels);
-			int incrementBlackMs = getLabelledValueInt(command, "binc", goLabels);
-			// Calculate think time for move
-			int thinkTime = bot->chooseMoveTime(timeRemainingWhiteMs, timeRemainingBlackMs, incrementWhiteMs, incrementBlackMs);
-			string str = "Thinking for: " + to_string(thinkTime);
-			respond(str + " ms.");
-			bot->generateMove(thinkTime); // Get move
+			infiniteSearch = depth == 0 && nodes == 0ULL && mate == 0;
+			post([=] {
+				bot->setSearchLimits(depth, nodes, mate, searchMoves);
+				bot->go();
+			});
 		}
-
 	}
 	// Process position command, sets up position of board via FEN, start position, 
 	// and optionally moves on given position
 	void IUCI::processPositionCommand(string command) {
-		// Do not process if currently searching
-		if (goThread.joinable()) {
-			return;
+		// Moves to play on the given position are optional
+		vector<string> moveList;
+		if (StringUtil::contains(command, "moves")) {
+			string allMoves = getLabelledValue(command, "moves", positionLabels);
+			if (allMoves.size() > 0) {
+				moveList = StringUtil::splitString(allMoves);
+			}
 		}
 		// If startpos position, reset to starting position
 		if (StringUtil::contains(StringUtil::toLower(command), "startpos")) {
-			bot->setPosition(FEN::startpos);
+			bot->setPosition(FEN::startpos, moveList);
 		} 
 		// Else, extract FEN string and load that position
 		else if (StringUtil::contains(StringUtil::toLower(command), "fen")) {
 			string customFEN = getLabelledValue(command, "fen", positionLabels);
-			bot->setPosition(customFEN);
-		} else {
-			return;
-		}
-		// If user provides moves to play on given position, enact them on board
-		string allMoves = getLabelledValue(command, "moves", positionLabels);
-		if (allMoves.size() > 0) {
-			vector<string> moveList = StringUtil::splitString(allMoves);
-			for (string& move : moveList) {
-				bot->makeMove(move);
-			}
+			bot->setPosition(customFEN, moveList);
 		}
 	}
 	// Set an option from user input
@@ -195,10 +355,9 @@ namespace SandalBot {
 
 		optionHandler->processOption(optionName, optionValue);
 	}
-	// Prints response parameter and logs it to file
+	// Writes response parameter as a line, after any buffered output
 	void IUCI::respond(string response) {
-		cout << response << endl;
-		cout.flush();
+		writer.writeLine(response);
 	}
 
 	template <typename T, std::size_t N>
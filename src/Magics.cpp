@@ -1,32 +1,172 @@
 #include "Magics.h"
 
+#include <bit>
+
+#if defined(__GNUC__)
+	#include <cpuid.h>
+#endif
+
 namespace SandalBot::BitMagics {
 
-	// Move Hashtables
-	std::unique_ptr<Bitboard[]> orthogonalMoves[SQUARES_NB];
-	std::unique_ptr<Bitboard[]> diagonalMoves[SQUARES_NB];
+	Backend backend{ Backend::MAGIC };
+
+	// Row and column steps of each sliding direction
+	using SlideSteps = int[4][2];
+	constexpr SlideSteps orthogonalSteps{ { -1, 0 }, { 1, 0 }, { 0, 1 }, { 0, -1 } };
+	constexpr SlideSteps diagonalSteps{ { -1, -1 }, { -1, 1 }, { 1, 1 }, { 1, -1 } };
+
+	static constexpr bool onBoard(int row, int col) {
+		return row >= 0 && row < 8 && col >= 0 && col < 8;
+	}
+
+	// Squares along every ray from a square which may block, the last square of a ray cannot block anything behind it
+	static constexpr Bitboard createBlockerMask(Square square, const SlideSteps& steps) {
+		Bitboard mask = 0ULL;
+
+		for (const auto& step : steps) {
+			int row = toRow(square) + step[0];
+			int col = toCol(square) + step[1];
+			while (onBoard(row + step[0], col + step[1])) {
+				mask |= 1ULL << (row * 8 + col);
+				row += step[0];
+				col += step[1];
+			}
+		}
+
+		return mask;
+	}
+
+	// Squares from a square to the board edge in one direction
+	static constexpr Bitboard createRay(Square square, const int (&step)[2]) {
+		Bitboard ray = 0ULL;
+		int row = toRow(square) + step[0];
+		int col = toCol(square) + step[1];
+		while (onBoard(row, col)) {
+			ray |= 1ULL << (row * 8 + col);
+			row += step[0];
+			col += step[1];
+		}
+		return ray;
+	}
+
+	struct SlideRays {
+		Bitboard rays[4][SQUARES_NB]{};
+		bool increasing[4]{}; // Whether squares increase along the direction
+	};
+
+	static constexpr SlideRays createRays(const SlideSteps& steps) {
+		SlideRays result{};
+		for (int dir = 0; dir < 4; dir++) {
+			result.increasing[dir] = steps[dir][0] * 8 + steps[dir][1] > 0;
+			for (Square square = START_SQUARE; square < SQUARES_NB; ++square) {
+				result.rays[dir][square] = createRay(square, steps[dir]);
+			}
+		}
+		return result;
+	}
+
+	constexpr SlideRays orthogonalRays = createRays(orthogonalSteps);
+	constexpr SlideRays diagonalRays = createRays(diagonalSteps);
+
+	// Returns movement bitboard from a square and set of blockers, including the first blocker of each ray.
+	// Squares behind the nearest blocker are removed using the blocker's own ray
+	static constexpr Bitboard createMovement(Square square, Bitboard blockers, const SlideRays& rays) {
+		Bitboard movementBoard = 0ULL;
+
+		for (int dir = 0; dir < 4; dir++) {
+			Bitboard ray = rays.rays[dir][square];
+			Bitboard rayBlockers = ray & blockers;
+			if (rayBlockers != 0ULL) {
+				int blocker = rays.increasing[dir] ? std::countr_zero(rayBlockers) : 63 - std::countl_zero(rayBlockers);
+				ray &= ~rays.rays[dir][blocker];
+			}
+			movementBoard |= ray;
+		}
+
+		return movementBoard;
+	}
+
+	// Creates the entries of every square, laying out each backend's moves consecutively from magicStart and pextStart
+	static constexpr std::array<SlidingEntry, SQUARES_NB> createEntries(const SlideSteps& steps, const MagicInfo (&magics)[SQUARES_NB],
+		const int (&maxIndexes)[SQUARES_NB], std::size_t magicStart, std::size_t pextStart) {
+		std::array<SlidingEntry, SQUARES_NB> entries{};
 
-	// Initialise hashmaps but creating hashmap for each square of correct size
-	void initMagics() {
 		for (Square square = START_SQUARE; square < SQUARES_NB; ++square) {
+			SlidingEntry& entry = entries[square];
+			entry.mask = createBlockerMask(square, steps);
+			entry.magic = magics[square].magic;
+			entry.rightShift = magics[square].rightShift;
+			entry.offsets[int(Backend::MAGIC)] = uint32_t(magicStart);
+			entry.offsets[int(Backend::PEXT)] = uint32_t(pextStart);
+
 			// Size is one greater than max index
-			orthogonalMoves[square] = std::make_unique<Bitboard[]>(maxOrthogonalIndexes[square] + 1);
-			diagonalMoves[square] = std::make_unique<Bitboard[]>(maxDiagonalIndexes[square] + 1);;
+			magicStart += std::size_t(maxIndexes[square]) + 1;
+			pextStart += std::size_t(1) << std::popcount(entry.mask);
 		}
+
+		return entries;
 	}
 
-	// Inserts orthogonal movement bitboards for each blocker
-	void addOrthogonalMoves(Square square, std::vector<Bitboard>& blockers, std::vector<Bitboard>& movementBoards) {
-		for (std::size_t i = 0; i < blockers.size(); i++) {
-			orthogonalMoves[square].get()[getOrthIndex(blockers[i], square)] = movementBoards[i];
+	constexpr std::array<SlidingEntry, SQUARES_NB> orthogonalEntries = createEntries(orthogonalSteps, orthogonalMagics,
+		maxOrthogonalIndexes, 0, orthogonalMagicSize + diagonalMagicSize);
+	constexpr std::array<SlidingEntry, SQUARES_NB> diagonalEntries = createEntries(diagonalSteps, diagonalMagics,
+		maxDiagonalIndexes, orthogonalMagicSize, orthogonalMagicSize + diagonalMagicSize + orthogonalPextSize);
+
+	static_assert(orthogonalEntries[SQUARES_NB - 1].offsets[int(Backend::PEXT)] + (1ULL << std::popcount(orthogonalEntries[SQUARES_NB - 1].mask))
+		== orthogonalMagicSize + diagonalMagicSize + orthogonalPextSize, "orthogonalPextSize does not match blocker masks");
+	static_assert(diagonalEntries[SQUARES_NB - 1].offsets[int(Backend::PEXT)] + (1ULL << std::popcount(diagonalEntries[SQUARES_NB - 1].mask))
+		== attackTableSize, "diagonalPextSize does not match blocker masks");
+
+	// Inserts the movement bitboard of every blocker permutation under both backends
+	static constexpr void addMoves(std::array<Bitboard, attackTableSize>& table, const std::array<SlidingEntry, SQUARES_NB>& entries,
+		const SlideRays& rays) {
+		for (Square square = START_SQUARE; square < SQUARES_NB; ++square) {
+			const SlidingEntry& entry = entries[square];
+			// Carry-rippler enumerates subsets of the mask in increasing PEXT index order
+			Bitboard blockers = 0ULL;
+			std::size_t pextIndex = 0;
+			do {
+				Bitboard moves = createMovement(square, blockers, rays);
+				table[entry.offsets[int(Backend::PEXT)] + pextIndex] = moves;
+				table[entry.offsets[int(Backend::MAGIC)] + ((blockers * entry.magic) >> entry.rightShift)] = moves;
+
+				blockers = (blockers - entry.mask) & entry.mask;
+				pextIndex++;
+			} while (blockers != 0ULL);
 		}
 	}
 
-	// Inserts diagonal movement bitboards for each blocker
-	void addDiagonalMoves(Square square, std::vector<Bitboard>& blockers, std::vector<Bitboard>& movementBoards) {
-		for (std::size_t i = 0; i < blockers.size(); i++) {
-			diagonalMoves[square].get()[getDiagIndex(blockers[i], square)] = movementBoards[i];
+	static constexpr std::array<Bitboard, attackTableSize> createAttackTable() {
+		std::array<Bitboard, attackTableSize> table{};
+		addMoves(table, orthogonalEntries, orthogonalRays);
+		addMoves(table, diagonalEntries, diagonalRays);
+		return table;
+	}
+
+	// Move Hashtables
+	constexpr std::array<Bitboard, attackTableSize> attackTable = createAttackTable();
+
+	// Returns whether the CPU supports BMI2 and implements PEXT in hardware. AMD processors
+	// before Zen 3 (family 19h) microcode PEXT, which is slower than multiplying by a magic
+	bool pextSupported() {
+#if defined(__GNUC__)
+		unsigned int eax, ebx, ecx, edx;
+		if (!__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx) || !(ebx & bit_BMI2)) {
+			return false;
+		}
+
+		__get_cpuid(0, &eax, &ebx, &ecx, &edx);
+		// Vendor string "AuthenticAMD" is stored in ebx, edx, ecx
+		bool amd = ebx == 0x68747541 && edx == 0x69746e65 && ecx == 0x444d4163;
+		if (amd) {
+			__get_cpuid(1, &eax, &ebx, &ecx, &edx);
+			unsigned int family = ((eax >> 8) & 0xF) + ((eax >> 20) & 0xFF);
+			return family >= 0x19;
 		}
+		return true;
+#else
+		return false;
+#endif
 	}
 
-}
\ No newline at end of file
+}
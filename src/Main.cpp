@@ -6,17 +6,23 @@
 
 using namespace SandalBot;
 
-int main() {
+int main(int argc, char* argv[]) {
 	initGlobals();
 	
 	IUCI engine;
 
-	// Repeatedly accept commands
-	std::string command = "";
-	while (command != "quit") {
-		std::getline(std::cin, command);
-		engine.processCommand(command); // Let engine process command
+	// Arguments are run as a single command, e.g. 'SandalBotV2 bench 6 1 16'
+	if (argc > 1) {
+		std::string command = argv[1];
+		for (int i = 2; i < argc; i++) {
+			command += std::string(" ") + argv[i];
+		}
+		engine.processCommand(command);
+		return 0;
 	}
 
+	// Repeatedly accept commands until quit or the end of input
+	engine.loop(std::cin);
+
 	return 0;
 }
\ No newline at end of file
@@ -1,6 +1,7 @@
 #include "MoveGen.h"
 #include "MoveOrderer.h"
 
+#include <cassert>
 #include <iostream>
 #include <limits>
 #include <stdexcept>
@@ -10,70 +11,125 @@ using namespace std;
 
 namespace SandalBot {
 
-	// Generates all legal moves on the board. Returns the number of legalmoves
+	// Generates the moves of slice Gen on the board. Returns the number of moves
 	// and populates the decayed moves array (Must be minimum length of 218 - maximum possible moves).
-	// capturesOnly determines whether only capture moves are considered
-	int MoveGen::generate(MovePoint moves[], bool capturesOnly) {
-		board->sideToMove() == WHITE 
-			? generateAllMoves<WHITE>(moves, capturesOnly) : generateAllMoves<BLACK>(moves, capturesOnly);
+	template <GenType Gen>
+	int MoveGen::generate(MovePoint moves[]) {
+		initVariables<Gen>(); // Setup variables for current board, including pins and check
+		assert(Gen != EVASIONS || isCheck);
 
-		return currentMoves;
+		Color us = board->sideToMove();
+
+		// When in check, every legal move is an evasion. Pseudo legal evasions leave pins and king safety to Board::isLegal
+		if ((Gen == LEGAL || Gen == EVASIONS || Gen == PSEUDO_LEGAL) && isCheck) {
+			return us == WHITE ? generateEvasions<WHITE>(moves) : generateEvasions<BLACK>(moves);
+		}
+
+		return us == WHITE ? generateAllMoves<WHITE, Gen>(moves) : generateAllMoves<BLACK, Gen>(moves);
 	}
 
-	template <Color Us>
-	int MoveGen::generateAllMoves(MovePoint moves[], bool capturesOnly) {
-		initVariables(); // Setup variables for current board
-		generateCheckData<Us>(); // Determine pins and check
+	template <Color Us, GenType Gen>
+	int MoveGen::generateAllMoves(MovePoint moves[]) {
+		if constexpr (Gen == QUIET_CHECKS) {
+			checkInfo = &board->checkInfo();
+		}
 
-		generateKingMoves<Us>(moves, capturesOnly);
+		generateKingMoves<Us, Gen>(moves);
 
 		// If king is checked twice, only legal moves is to move king
 		if (doubleCheck)
 			return currentMoves;
 
-		generatePawnMoves<Us>(moves, capturesOnly);
-		generateMoves<Us, QUEEN>(moves, capturesOnly);
-		generateMoves<Us, KNIGHT>(moves, capturesOnly);
-		generateMoves<Us, BISHOP>(moves, capturesOnly);
-		generateMoves<Us, ROOK>(moves, capturesOnly);
+		// Squares the other pieces may move to
+		Bitboard targets = Gen == CAPTURES ? board->colorsBB[~Us]
+			: Gen == LEGAL || Gen == PSEUDO_LEGAL ? ~board->colorsBB[Us]
+			: ~board->typesBB[ALL_PIECES];
+
+		if (isCheck) {
+			targets &= checkMask;
+		}
+
+		generatePawnMoves<Us, Gen>(moves, targets);
+		generateMoves<Us, QUEEN, Gen>(moves, targets);
+		generateMoves<Us, KNIGHT, Gen>(moves, targets);
+		generateMoves<Us, BISHOP, Gen>(moves, targets);
+		generateMoves<Us, ROOK, Gen>(moves, targets);
+
+		return currentMoves;
+	}
+
+	// Generates moves resolving a check: king moves, and for a single checker, captures of
+	// the checker and blocks of its line. Castling is never legal in check
+	template <Color Us>
+	int MoveGen::generateEvasions(MovePoint moves[]) {
+		generateKingMoves<Us, EVASIONS>(moves);
+
+		if (doubleCheck)
+			return currentMoves;
+
+		Bitboard targets = checkMask;
+
+		generatePawnMoves<Us, EVASIONS>(moves, targets);
+		generateMoves<Us, QUEEN, EVASIONS>(moves, targets);
+		generateMoves<Us, KNIGHT, EVASIONS>(moves, targets);
+		generateMoves<Us, BISHOP, EVASIONS>(moves, targets);
+		generateMoves<Us, ROOK, EVASIONS>(moves, targets);
 
 		return currentMoves;
 	}
 
 	// Initialise variables for move generation
+	template <GenType Gen>
 	void MoveGen::initVariables() {
-		isCheck = false;
-		doubleCheck = false;
+		if constexpr (Gen == PSEUDO_LEGAL) {
+			// Only the checkers are needed, which restrict the moves to evasions
+			Square kSq = board->kingSquares[board->sideToMove()];
+			Bitboard checkers = board->checkers();
+
+			isCheck = checkers != 0ULL;
+			doubleCheck = (checkers & (checkers - 1ULL)) != 0ULL;
+			checkMask = isCheck ? (getLineBetweenBB(kSq, LSB(checkers)) & ~(1ULL << kSq)) | checkers : 0ULL;
+			pinned = 0ULL;
+			opponentAttacks = 0ULL;
+		} else {
+			const AttackInfo& attackInfo = board->attacks();
+
+			isCheck = attackInfo.isCheck();
+			doubleCheck = attackInfo.isDoubleCheck();
+			checkMask = attackInfo.checkMask;
+			pinned = attackInfo.pinned;
+			opponentAttacks = attackInfo.opponentAttacks;
+		}
 
 		currentMoves = 0ULL;
+	}
 
-		checkBB = 0ULL;
-		checkRayBB = 0ULL;
-		opponentAttacks = 0ULL;
+	// Squares a piece of type Type on from gives check by moving to
+	Bitboard MoveGen::quietCheckTargets(PieceType type, Square from, Square enemyKing) const {
+		Bitboard targets = checkInfo->checkSquares[type];
+		if (checkInfo->discoveredCandidates & (1ULL << from)) {
+			targets |= ~getLineBB(from, enemyKing);
+		}
+		return targets;
 	}
 
-	template<Color Us, PieceType Type>
-	void MoveGen::generateMoves(MovePoint moves[], bool capturesOnly) {
+	template<Color Us, PieceType Type, GenType Gen>
+	void MoveGen::generateMoves(MovePoint moves[], Bitboard targets) {
 		Bitboard pieces = board->typesBB[Type] & board->colorsBB[Us];
 	
 		while (pieces != 0ULL) {
 			Square from = popLSB(pieces);
-			Bitboard movementBB = getMovementBoard<Type>(from, board->typesBB[ALL_PIECES]);
-			movementBB &= ~board->colorsBB[Us];
+			Bitboard movementBB = getMovementBoard<Type>(from, board->typesBB[ALL_PIECES]) & targets;
 			
-			bool pinned = checkRayBB && (checkRayBB & (1ULL << from));
+			bool isPinned = pinned & (1ULL << from);
 
-			if (pinned) {
+			if (isPinned) {
 				Bitboard pinLine = getLineBB(from, board->kingSquares[Us]);
 				movementBB &= pinLine;
 			}
 
-			if (isCheck) {
-				movementBB &= checkBB;
-			}
-
-			if (capturesOnly) {
-				movementBB &= board->colorsBB[~Us];
+			if constexpr (Gen == QUIET_CHECKS) {
+				movementBB &= quietCheckTargets(Type, from, board->kingSquares[~Us]);
 			}
 
 			while (movementBB != 0ULL) {
@@ -84,42 +140,109 @@ namespace SandalBot {
 	}
 
 	// Generate all possible moves for pawns, including the many odd moves pawns can make.
+	// Pushes and captures of unpinned pawns are computed set-wise by shifting the pawn bitboard,
+	// and targets are only serialised when the moves are emitted.
 	// Populates decayed moves array with new moves
-	template <Color Us>
-	void MoveGen::generatePawnMoves(MovePoint moves[], bool capturesOnly) {
+	template <Color Us, GenType Gen>
+	void MoveGen::generatePawnMoves(MovePoint moves[], Bitboard targets) {
 		constexpr Direction pawnUp = pawnPush(Us);
+		constexpr Direction upEast = Us == WHITE ? NORTH_EAST : SOUTH_EAST;
+		constexpr Direction upWest = Us == WHITE ? NORTH_WEST : SOUTH_WEST;
 		constexpr Row startRow = Us == WHITE ? ROW_2 : ROW_7;
 		constexpr Row twoSquaresRow = Us == WHITE ? ROW_4 : ROW_5;
 		constexpr Row promoteRow = Us == WHITE ? ROW_7 : ROW_2;
+		// Row a pawn reaches after a single push from its starting row
+		constexpr Bitboard doublePushMask = rowMask << ((Us == WHITE ? ROW_3 : ROW_6) * 8);
+		constexpr Bitboard promoteMask = rowMask << (promoteRow * 8);
+		constexpr bool genQuiets = Gen != CAPTURES;
+		constexpr bool genCaptures = Gen != QUIETS && Gen != QUIET_CHECKS;
+		constexpr bool genPromotions = Gen != QUIET_CHECKS;
 
 		Bitboard pawns = board->typesBB[PAWN] & board->colorsBB[Us];
-		Bitboard allPieces = board->typesBB[ALL_PIECES];
-		Bitboard emptySquares = ~allPieces;
-		bool epAvailable = board->state->enPassantSquare != NONE_SQUARE;
+		Bitboard emptySquares = ~board->typesBB[ALL_PIECES];
+		Bitboard enemies = board->colorsBB[~Us];
+
+		// Pinned pawns can only move along their pin line and are generated individually
+		Bitboard pinnedPawns = pawns & pinned;
+		Bitboard freePawns = pawns & ~pinnedPawns & ~promoteMask;
+		Bitboard promotingPawns = pawns & ~pinnedPawns & promoteMask;
+
+		if constexpr (genQuiets) {
+			Bitboard singlePushes = shift<pawnUp>(freePawns) & emptySquares;
+			Bitboard doublePushes = shift<pawnUp>(singlePushes & doublePushMask) & emptySquares & targets;
+			singlePushes &= targets;
+
+			if constexpr (Gen == QUIET_CHECKS) {
+				// Pushes give check directly, or discover a check unless the pawn blocks along its own column
+				Bitboard discoveringPawns = freePawns & checkInfo->discoveredCandidates & ~getColMask(board->kingSquares[~Us]);
+				singlePushes &= checkInfo->checkSquares[PAWN] | shift<pawnUp>(discoveringPawns);
+				doublePushes &= checkInfo->checkSquares[PAWN] | shift<pawnUp>(shift<pawnUp>(discoveringPawns));
+			}
 
-		while (pawns != 0ULL) {
-			Square from = popLSB(pawns);
-			Bitboard pushBB = capturesOnly ? 0ULL : ((1ULL << (from + pawnUp)) & emptySquares);
+			while (singlePushes != 0ULL) {
+				Square to = popLSB(singlePushes);
+				addMove(moves, to - pawnUp, to);
+			}
 
-			if (pushBB != 0ULL && toRow(from) == startRow && ((1ULL << (from + 2 * pawnUp)) & emptySquares) != 0ULL) {
-				pushBB |= 1ULL << (from + 2 * pawnUp);
+			while (doublePushes != 0ULL) {
+				Square to = popLSB(doublePushes);
+				addMove(moves, to - pawnUp - pawnUp, to, Move::Flag::PAWN_TWO_SQUARES);
+			}
+		}
+
+		if constexpr (genCaptures) {
+			Bitboard eastCaptures = shift<upEast>(freePawns) & enemies & targets;
+			Bitboard westCaptures = shift<upWest>(freePawns) & enemies & targets;
+
+			while (eastCaptures != 0ULL) {
+				Square to = popLSB(eastCaptures);
+				addMove(moves, to - upEast, to);
 			}
 
-			Bitboard attackBB = getPawnAttackMoves<Us>(from) & allPieces;
+			while (westCaptures != 0ULL) {
+				Square to = popLSB(westCaptures);
+				addMove(moves, to - upWest, to);
+			}
+		}
 
-			Bitboard movementBB = pushBB | attackBB;
+		if (genPromotions && promotingPawns != 0ULL) {
+			Bitboard pushPromotions = genQuiets ? shift<pawnUp>(promotingPawns) & emptySquares & targets : 0ULL;
+			Bitboard eastPromotions = genCaptures ? shift<upEast>(promotingPawns) & enemies & targets : 0ULL;
+			Bitboard westPromotions = genCaptures ? shift<upWest>(promotingPawns) & enemies & targets : 0ULL;
 
-			movementBB &= ~board->colorsBB[Us];
+			while (pushPromotions != 0ULL) {
+				Square to = popLSB(pushPromotions);
+				promotionMoves<Us>(moves, to - pawnUp, to);
+			}
 
-			bool isPinned = checkRayBB && (checkRayBB & (1ULL << from));
+			while (eastPromotions != 0ULL) {
+				Square to = popLSB(eastPromotions);
+				promotionMoves<Us>(moves, to - upEast, to);
+			}
 
-			if (isPinned) {
-				Bitboard pinLine = getLineBB(from, board->kingSquares[Us]);
-				movementBB &= pinLine;
+			while (westPromotions != 0ULL) {
+				Square to = popLSB(westPromotions);
+				promotionMoves<Us>(moves, to - upWest, to);
+			}
+		}
+
+		while (pinnedPawns != 0ULL) {
+			Square from = popLSB(pinnedPawns);
+			if (!genPromotions && toRow(from) == promoteRow) {
+				continue;
 			}
 
-			if (isCheck) {
-				movementBB &= checkBB;
+			Bitboard pushBB = genQuiets ? ((1ULL << (from + pawnUp)) & emptySquares) : 0ULL;
+
+			if (pushBB != 0ULL && toRow(from) == startRow && ((1ULL << (from + 2 * pawnUp)) & emptySquares) != 0ULL) {
+				pushBB |= 1ULL << (from + 2 * pawnUp);
+			}
+
+			Bitboard attackBB = genCaptures ? getPawnAttackMoves<Us>(from) & enemies : 0ULL;
+			Bitboard movementBB = (pushBB | attackBB) & targets & getLineBB(from, board->kingSquares[Us]);
+
+			if constexpr (Gen == QUIET_CHECKS) {
+				movementBB &= quietCheckTargets(PAWN, from, board->kingSquares[~Us]);
 			}
 
 			while (movementBB != 0ULL) {
@@ -133,12 +256,20 @@ namespace SandalBot {
 					addMove(moves, from, to);
 				}
 			}
-			
-			Bitboard epBB = getPawnAttackMoves<Us>(from) & (1ULL << board->state->enPassantSquare);
+		}
+
+		if constexpr (genCaptures) {
+			// Pawns which could capture onto the en passant square are those attacked from it by an enemy pawn
+			Square enPassantSquare = board->state->enPassantSquare;
 
-			if (epBB != 0ULL && epAvailable) {
-				enPassantMoves<Us>(moves, from, board->state->enPassantSquare, isPinned);
-			} 
+			if (enPassantSquare != NONE_SQUARE) {
+				Bitboard epPawns = getPawnAttackMoves<~Us>(enPassantSquare) & pawns;
+
+				while (epPawns != 0ULL) {
+					Square from = popLSB(epPawns);
+					enPassantMoves<Us>(moves, from, enPassantSquare, pinned & (1ULL << from));
+				}
+			}
 		}
 	}
 
@@ -148,7 +279,7 @@ namespace SandalBot {
 		Square enemyPawnSquare = to - pawnPush(Us);
 		// If in check, and own pawn does not block check and enemy pawn being taken isnt the checking piece, 
 		// cannot en passant
-		if (isCheck && !(checkBB & (1ULL << to)) && !(checkBB & (1ULL << enemyPawnSquare)))
+		if (isCheck && !(checkMask & (1ULL << to)) && !(checkMask & (1ULL << enemyPawnSquare)))
 			return;
 
 		if (isPinned) {
@@ -203,8 +334,8 @@ namespace SandalBot {
 
 	// Generate all possible moves for king.
 	// Populates decayed moves array with new moves
-	template <Color Us>
-	void MoveGen::generateKingMoves(MovePoint moves[], bool capturesOnly) {
+	template <Color Us, GenType Gen>
+	void MoveGen::generateKingMoves(MovePoint moves[]) {
 		constexpr CastlingRights crMask = (Us == WHITE ? W_RIGHTS : B_RIGHTS);
 		Square from = board->kingSquares[Us];
 
@@ -213,9 +344,14 @@ namespace SandalBot {
 		moveBitboard &= ~(opponentAttacks); // Disallow moving into opponent checks
 		moveBitboard &= ~(board->colorsBB[Us]); // Avoid capturing own pieces
 
-		// If captures only, only allow capturing enemy pieces
-		if (capturesOnly)
+		if constexpr (Gen == CAPTURES) {
 			moveBitboard &= board->colorsBB[~Us];
+		} else if constexpr (Gen == QUIETS) {
+			moveBitboard &= ~board->typesBB[ALL_PIECES];
+		} else if constexpr (Gen == QUIET_CHECKS) {
+			// The king can only give a discovered check
+			moveBitboard &= ~board->typesBB[ALL_PIECES] & quietCheckTargets(KING, from, board->kingSquares[~Us]);
+		}
 
 		// Add all available moves
 		while (moveBitboard != 0ULL) {
@@ -225,8 +361,10 @@ namespace SandalBot {
 		}
 
 		// If king can castle, generate moves
-		if (!capturesOnly && !isCheck && (crMask & board->state->cr) != NO_RIGHTS)
-			castlingMoves<Us>(moves, from);
+		if constexpr (Gen == QUIETS || Gen == LEGAL || Gen == PSEUDO_LEGAL) {
+			if (!isCheck && (crMask & board->state->cr) != NO_RIGHTS)
+				castlingMoves<Us>(moves, from);
+		}
 	}
 
 	template <Color Us>
@@ -245,136 +383,11 @@ namespace SandalBot {
 		}
 	}
 
-	template <Color Us>
-	Bitboard MoveGen::generatePawnAttackData() {
-		Bitboard attackBB = 0ULL;
-
-		Bitboard pawns = board->typesBB[PAWN] & board->colorsBB[~Us];
-
-		// Add only attack movement to overall attack board
-		while (pawns != 0ULL) {
-			Square from = popLSB(pawns);
-			Bitboard movementBB = getPawnAttackMoves<~Us>(from);
-			attackBB |= movementBB;
-		}
-
-		return attackBB;
-	}
-
-	template <Color Us, PieceType Type>
-	Bitboard MoveGen::generateAttackData() {
-		Bitboard attackBB = 0ULL;
-
-		Bitboard pieces = board->typesBB[Type] & board->colorsBB[~Us];
-		Bitboard blockers = board->typesBB[ALL_PIECES] & ~(1ULL << board->kingSquares[Us]);
-
-		// Add movement to overall attack board
-		while (pieces != 0ULL) {
-			Square from = popLSB(pieces);
-			
-			Bitboard movementBB = getMovementBoard<Type>(from, blockers);
-
-			attackBB |= movementBB;
-		}
-
-		return attackBB;
-	}
-
-	template <Color Us>
-	// Generate attack movement from opponent for all pieces
-	void MoveGen::generateAllAttackData() {
-		opponentAttacks |= getMovementBoard<KING>(board->kingSquares[~Us], 0ULL);
-		opponentAttacks |= generateAttackData<Us, QUEEN>();
-		opponentAttacks |= generateAttackData<Us, ROOK>();
-		opponentAttacks |= generateAttackData<Us, BISHOP>();
-		opponentAttacks |= generateAttackData<Us, KNIGHT>();
-		opponentAttacks |= generatePawnAttackData<Us>();
-	}
-
-	template <Color Us>
-	// Calculate check and pin data to calculate where king can move
-	void MoveGen::generateCheckData() {
-		generateAllAttackData<Us>();
-
-		Square kSq = board->kingSquares[Us];
-		Bitboard friendlyBoard = board->colorsBB[Us];
-		Bitboard enemyBoard = board->colorsBB[~Us];
-		Bitboard temp;
-		Bitboard enemyBlockers;
-		// Get pieces 'blocking' kings orthogonal and diagonal view
-		Bitboard orthogonalBlockers = board->typesBB[ALL_PIECES] & getBlockerOrthogonalMask(kSq);
-		Bitboard diagonalBlockers = board->typesBB[ALL_PIECES] & getBlockerDiagonalMask(kSq);
-		// Get kings orthogonal 'vision'
-		temp = getOrthMovementBoard(kSq, orthogonalBlockers);
-		Bitboard checkBoard = temp;
-		enemyBlockers = temp & enemyBoard & (board->typesBB[ROOK] | board->typesBB[QUEEN]); // See if enemy orthogonal pieces attack the king
-		// Get kings diagonal 'vision'
-		temp = getDiagMovementBoard(kSq, diagonalBlockers);
-		checkBoard |= temp;
-		enemyBlockers |= temp & enemyBoard & (board->typesBB[BISHOP] | board->typesBB[QUEEN]); // See if enemy diagonal pieces attack king
-
-		// For each diagonal/orthogonal piece that attacks the king
-		while (enemyBlockers != 0ULL) {
-			// Get mask with line between king and enemy piece
-			Square to = popLSB(enemyBlockers);
-			temp = getLineBetweenBB(kSq, to);
-			checkBB |= temp & checkBoard; // Add line between king and enemy to check bitboard
-			// Update check and double check
-			doubleCheck = isCheck;
-			isCheck = true;
-			if (doubleCheck)
-				break;
-		}
-		// Now that check lines have been done, now calculate 'rays' that pin friendly pieces
-
-		// Take out first 'sight' of any friendly pieces, to only see second wave pieces which
-		// may or may not pin those friendly pieces from behind
-		orthogonalBlockers &= ~(checkBoard & friendlyBoard);
-		diagonalBlockers &= ~(checkBoard & friendlyBoard);
-
-		// Same logic as check but for pieces behind first wave friendly pieces
-		temp = getOrthMovementBoard(kSq, orthogonalBlockers);
-		checkBoard = temp;
-		enemyBlockers = temp & enemyBoard & (board->typesBB[ROOK] | board->typesBB[QUEEN]);
-		temp = getDiagMovementBoard(kSq, diagonalBlockers);
-		checkBoard |= temp;
-		enemyBlockers |= temp & enemyBoard & (board->typesBB[BISHOP] | board->typesBB[QUEEN]);
-		// For every enemy piece pinning friendly pieces
-		while (enemyBlockers != 0ULL) {
-			Square to = popLSB(enemyBlockers);
-			temp = getLineBetweenBB(kSq, to);
-			checkRayBB |= temp & checkBoard; // Add 'ray' between king and enemy piece to rays
-		}
-
-		// See if any knights check the king
-		Bitboard enemyKnights = board->typesBB[KNIGHT] & enemyBoard;
-		Bitboard knightMoveBitboard = getMovementBoard<KNIGHT>(kSq, 0ULL);
-		knightMoveBitboard &= enemyKnights;
-
-		checkBB |= knightMoveBitboard;
-		// Update check status if king can see any knights
-		while (knightMoveBitboard != 0ULL) {
-			popLSB(knightMoveBitboard);
-			doubleCheck = isCheck;
-			isCheck = true;
-			if (doubleCheck)
-				break;
-		}
-		
-		// See if any pawns can check the king
-		Bitboard enemyPawns = board->typesBB[PAWN] & enemyBoard;
-		Bitboard pawnMoveBitboard = getPawnAttackMoves<Us>(kSq);
-		pawnMoveBitboard &= enemyPawns;
-
-		checkBB |= pawnMoveBitboard;
-		// Update check status if king is attacked by any pawns
-		while (pawnMoveBitboard != 0ULL) {
-			popLSB(pawnMoveBitboard);
-			doubleCheck = isCheck;
-			isCheck = true;
-			if (doubleCheck)
-				break;
-		}
-	}
+	template int MoveGen::generate<CAPTURES>(MovePoint moves[]);
+	template int MoveGen::generate<QUIETS>(MovePoint moves[]);
+	template int MoveGen::generate<QUIET_CHECKS>(MovePoint moves[]);
+	template int MoveGen::generate<EVASIONS>(MovePoint moves[]);
+	template int MoveGen::generate<LEGAL>(MovePoint moves[]);
+	template int MoveGen::generate<PSEUDO_LEGAL>(MovePoint moves[]);
 
-}
\ No newline at end of file
+}
@@ -1,6 +1,5 @@
 #include "MoveOrderer.h"
 
-#include "MoveGen.h"
 #include "Searcher.h"
 
 #include <algorithm>
@@ -13,10 +12,13 @@ namespace SandalBot {
 
 	// Assigns each move in decayed c array a heuristic value depending on its effectiveness.
 	// Sorts array based on list point values
-	void MoveOrderer::order(Board* board, MoveGen* generator, MovePoint moves[], Move bestMove, int numMoves, int depth, bool qSearch) {
+	void MoveOrderer::order(Board* board, MovePoint moves[], Move bestMove, int numMoves, int depth, bool qSearch) {
 		// No need to sort one move
 		if (numMoves <= 1) return;
 
+		// Squares defended by the opponent, shared with move generation
+		const Bitboard opponentAttacks = board->attacks().opponentAttacks;
+
 		// For each move
 		for (int it = 0; it < numMoves; ++it) {
 			// If not in quiescence search and found move is a previusly found best move, most likely best move
@@ -36,7 +38,7 @@ namespace SandalBot {
 			const Move::Flag flag = moves[it].move.flag();
 			PieceType ownPiece = typeOf(board->squares[from]);
 			PieceType enemyPiece = typeOf(board->squares[to]);
-			bool toDefended = generator->opponentAttacks & (1ULL << to);
+			bool toDefended = opponentAttacks & (1ULL << to);
 
 			assert(ownPiece != NO_PIECE_TYPE);
 
@@ -81,6 +83,11 @@ namespace SandalBot {
 				moveValue -= PieceEvaluations::pieceEvals[ownPiece][from];
 			}
 
+			// Checking moves force a reply and are never reduced, so search them early
+			if (!qSearch && moves[it].givesCheck) {
+				moveValue += checkValue;
+			}
+
 			// Moves with flags are most likely special (good)
 			switch (flag) {
 			case Move::Flag::NO_FLAG:
@@ -35,6 +35,129 @@ namespace SandalBot {
 		};
 
 		options[changeHashSize.name] = changeHashSize; // Add to map of options
+
+		// Changes margin the cheap evaluation must clear the search window by to skip full evaluation
+		Option lazyEvalMargin = {
+			"Lazy Eval Margin",
+			"type spin default 400 min 0 max 10000",
+			[this](std::string& value) {
+				int valueInt = std::stoi(value);
+				if (valueInt < 0 || valueInt > 10000) {
+					return;
+				}
+				this->bot->setLazyEvalMargin(valueInt);
+			}
+		};
+
+		options[lazyEvalMargin.name] = lazyEvalMargin;
+
+		// Switches between legal and pseudo legal move generation in search and perft
+		Option pseudoLegal = {
+			"Pseudo Legal Movegen",
+			"type check default false",
+			[this](std::string& value) {
+				this->bot->setPseudoLegal(value == "true");
+			}
+		};
+
+		options[pseudoLegal.name] = pseudoLegal;
+
+		// Changes size of the perft hash table, zero disables reuse of transposed subtrees
+		Option perftHashSize = {
+			"Perft Hash",
+			"type spin default 16 min 0 max 2000",
+			[this](std::string& value) {
+				int valueInt = std::stoi(value);
+				if (valueInt < 0 || valueInt > 2000) {
+					return;
+				}
+				this->bot->setPerftHashSize(valueInt);
+			}
+		};
+
+		options[perftHashSize.name] = perftHashSize;
+
+		// Changes number of threads used by perft, zero uses every hardware thread
+		Option perftThreads = {
+			"Perft Threads",
+			"type spin default 0 min 0 max 256",
+			[this](std::string& value) {
+				int valueInt = std::stoi(value);
+				if (valueInt < 0 || valueInt > 256) {
+					return;
+				}
+				this->bot->setPerftThreads(valueInt);
+			}
+		};
+
+		options[perftThreads.name] = perftThreads;
+
+		// Reports hardware performance counters per node after search, perft and bench
+		Option perfCounters = {
+			"Perf Counters",
+			"type check default false",
+			[this](std::string& value) {
+				this->bot->setPerfCounters(value == "true");
+			}
+		};
+
+		options[perfCounters.name] = perfCounters;
+
+		// Prints search counters after each iteration, as labelled values or JSON
+		Option searchStats = {
+			"Search Stats",
+			"type combo default Off var Off var Info var JSON",
+			[this](std::string& value) {
+				if (value == "Info") {
+					this->bot->setSearchStats(Searcher::StatsFormat::INFO);
+				} else if (value == "JSON") {
+					this->bot->setSearchStats(Searcher::StatsFormat::JSON);
+				} else {
+					this->bot->setSearchStats(Searcher::StatsFormat::OFF);
+				}
+			}
+		};
+
+		options[searchStats.name] = searchStats;
+
+		// Changes time reserved per move for communication delays between the engine and GUI
+		Option moveOverhead = {
+			"Move Overhead",
+			"type spin default 30 min 0 max 5000",
+			[this](std::string& value) {
+				int valueInt = std::stoi(value);
+				if (valueInt < 0 || valueInt > 5000) {
+					return;
+				}
+				this->bot->setMoveOverhead(valueInt);
+			}
+		};
+
+		options[moveOverhead.name] = moveOverhead;
+
+		// Changes the number of best moves searched and reported with their own principal variations
+		Option multiPV = {
+			"MultiPV",
+			"type spin default 1 min 1 max " + std::to_string(MoveGen::maxMoves),
+			[this](std::string& value) {
+				int valueInt = std::stoi(value);
+				if (valueInt < 1 || valueInt > MoveGen::maxMoves) {
+					return;
+				}
+				this->bot->setMultiPV(valueInt);
+			}
+		};
+
+		options[multiPV.name] = multiPV;
+
+		// Tells the engine the GUI may send 'go ponder', pondering itself is driven by the GUI
+		Option ponder = {
+			"Ponder",
+			"type check default false",
+			[]([[maybe_unused]] std::string& value) {}
+		};
+
+		options[ponder.name] = ponder;
 	}
 
 	// Invoke option action function
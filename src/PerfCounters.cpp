@@ -0,0 +1,146 @@
+#include "PerfCounters.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <iomanip>
+
+#if defined(__linux__)
+	#include <linux/perf_event.h>
+	#include <sys/ioctl.h>
+	#include <sys/syscall.h>
+	#include <unistd.h>
+#endif
+
+using namespace std;
+
+namespace SandalBot {
+
+#if defined(__linux__)
+	// Type and config of each event passed to perf_event_open
+	static constexpr uint32_t cacheMiss(uint32_t cache) {
+		return cache | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+	}
+
+	static constexpr struct {
+		uint32_t type;
+		uint64_t config;
+	} eventConfigs[PerfCounters::EVENT_NB]{
+		{ PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES },
+		{ PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS },
+		{ PERF_TYPE_HW_CACHE, cacheMiss(PERF_COUNT_HW_CACHE_L1D) },
+		{ PERF_TYPE_HW_CACHE, cacheMiss(PERF_COUNT_HW_CACHE_LL) },
+		{ PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES },
+		{ PERF_TYPE_HW_CACHE, cacheMiss(PERF_COUNT_HW_CACHE_DTLB) },
+	};
+#endif
+
+	PerfCounters::~PerfCounters() {
+		close();
+	}
+
+	// Opens and enables every event, returns false if no event could be opened. Events are opened
+	// individually rather than as a group, since inherited counters cannot be read as a group
+	bool PerfCounters::start() {
+		close();
+		lastError.clear();
+		fill(begin(counted), end(counted), false);
+		fill(begin(counts), end(counts), 0ULL);
+
+#if defined(__linux__)
+		bool anyOpened = false;
+		for (int event = 0; event < EVENT_NB; ++event) {
+			perf_event_attr attr{};
+			attr.size = sizeof(attr);
+			attr.type = eventConfigs[event].type;
+			attr.config = eventConfigs[event].config;
+			attr.disabled = 1;
+			attr.inherit = 1;
+			attr.exclude_kernel = 1;
+			attr.exclude_hv = 1;
+			attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+			fds[event] = int(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+			if (fds[event] == -1) {
+				lastError = strerror(errno);
+				continue;
+			}
+			anyOpened = true;
+		}
+
+		for (int fd : fds) {
+			if (fd != -1) {
+				ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+				ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+			}
+		}
+		return anyOpened;
+#else
+		lastError = "perf_event_open requires Linux";
+		return false;
+#endif
+	}
+
+	// Disables and reads every open event. Counts are scaled up if the kernel multiplexed
+	// the event with others and it was only running for part of the time
+	void PerfCounters::stop() {
+#if defined(__linux__)
+		for (int fd : fds) {
+			if (fd != -1) {
+				ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+			}
+		}
+
+		for (int event = 0; event < EVENT_NB; ++event) {
+			uint64_t values[3]{}; // Count, time enabled, time running
+			if (fds[event] == -1 || read(fds[event], values, sizeof(values)) != sizeof(values) || values[2] == 0) {
+				continue;
+			}
+
+			counts[event] = values[0];
+			if (values[2] < values[1]) {
+				counts[event] = uint64_t(double(values[0]) * double(values[1]) / double(values[2]));
+			}
+			counted[event] = true;
+		}
+#endif
+		close();
+	}
+
+	void PerfCounters::report(ostream& out, uint64_t nodes, string_view prefix) const {
+		// Prevent division by zero
+		double perNode = 1.0 / double(max(nodes, uint64_t(1)));
+
+		out << prefix << "perf";
+		for (int event = 0; event < EVENT_NB; ++event) {
+			out << ' ' << eventNames[event] << "/node ";
+			if (counted[event]) {
+				out << fixed << setprecision(2) << double(counts[event]) * perNode;
+			} else {
+				out << "n/a";
+			}
+		}
+
+		if (counted[CYCLES] && counted[INSTRUCTIONS] && counts[CYCLES] != 0) {
+			out << " ipc " << fixed << setprecision(2) << double(counts[INSTRUCTIONS]) / double(counts[CYCLES]);
+		}
+		out << defaultfloat << setprecision(6) << '\n';
+
+		if (!lastError.empty()) {
+			out << prefix << "perf unavailable events: " << lastError << '\n';
+		}
+		out << flush;
+	}
+
+	void PerfCounters::close() {
+#if defined(__linux__)
+		for (int& fd : fds) {
+			if (fd != -1) {
+				::close(fd);
+				fd = -1;
+			}
+		}
+#endif
+	}
+
+}
@@ -0,0 +1,230 @@
+#include "Perft.h"
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+namespace SandalBot {
+
+	// Allocates the largest power of two number of entries fitting in sizeMB, zero frees the table
+	void PerftTable::resize(std::size_t sizeMB) {
+		std::size_t entryCount = (sizeMB * 1024ULL * 1024ULL) / sizeof(Entry);
+		size = 0;
+		if (entryCount > 0) {
+			size = 1;
+			while (size * 2 <= entryCount) {
+				size *= 2;
+			}
+		}
+		entries.reset(size > 0 ? new Entry[size] : nullptr);
+	}
+
+	bool PerftTable::probe(HashKey hash, int depth, uint64_t& nodes) const {
+		const Entry& entry = entries[hash & (size - 1)];
+		uint64_t data = entry.data.load(std::memory_order_relaxed);
+		uint64_t key = entry.key.load(std::memory_order_relaxed);
+
+		if ((key ^ data) != hash || int(data >> depthShift) != depth) {
+			return false;
+		}
+
+		nodes = data & nodesMask;
+		return true;
+	}
+
+	void PerftTable::store(HashKey hash, int depth, uint64_t nodes) {
+		Entry& entry = entries[hash & (size - 1)];
+		uint64_t data = (uint64_t(depth) << depthShift) | (nodes & nodesMask);
+
+		entry.key.store(hash ^ data, std::memory_order_relaxed);
+		entry.data.store(data, std::memory_order_relaxed);
+	}
+
+	Perft::Perft(Board* board) : board(board), moveGenerator(board) {}
+
+	// Returns the number of leaf nodes depth plies from the current position
+	uint64_t Perft::run(int depth) {
+		if (depth <= 0) {
+			return 1ULL;
+		}
+
+		if (hashSizeMB != 0 && table->empty()) {
+			table->resize(hashSizeMB);
+		}
+
+		if (threadCount() == 1 || depth < minParallelDepth) {
+			return subtree(depth);
+		}
+
+		MovePoint moves[MoveGen::maxMoves];
+		uint64_t rootNodes[MoveGen::maxMoves];
+		int numMoves = pseudoLegal ? generate<true>(moves) : generate<false>(moves);
+		divideParallel(depth, moves, numMoves, rootNodes);
+
+		uint64_t totalNodes{ 0ULL };
+		for (int i = 0; i < numMoves; ++i) {
+			totalNodes += rootNodes[i];
+		}
+		return totalNodes;
+	}
+
+	// Returns the number of leaf nodes depth plies from the current position, and reports the
+	// count below each root move to the listener. Moves are reported in generation order once all
+	// counts are known, so the results do not depend on threads
+	uint64_t Perft::divide(int depth, SearchListener& listener) {
+		if (depth <= 0) {
+			return 1ULL;
+		}
+
+		if (hashSizeMB != 0 && table->empty()) {
+			table->resize(hashSizeMB);
+		}
+
+		MovePoint moves[MoveGen::maxMoves];
+		uint64_t rootNodes[MoveGen::maxMoves];
+		int numMoves = pseudoLegal ? generate<true>(moves) : generate<false>(moves);
+
+		if (threadCount() > 1 && depth >= minParallelDepth) {
+			divideParallel(depth, moves, numMoves, rootNodes);
+		} else {
+			for (int i = 0; i < numMoves; ++i) {
+				board->makeMove(moves[i].move);
+				rootNodes[i] = subtree(depth - 1);
+				board->unMakeMove();
+			}
+		}
+
+		uint64_t totalNodes{ 0ULL };
+		for (int i = 0; i < numMoves; ++i) {
+			listener.onPerftMove(moves[i].move, rootNodes[i]);
+			totalNodes += rootNodes[i];
+		}
+
+		return totalNodes;
+	}
+
+	// Sets the size of the hash table, a size of zero disables hashing
+	void Perft::setHashSize(int sizeMB) {
+		hashSizeMB = sizeMB;
+		table->resize(0);
+	}
+
+	int Perft::threadCount() const {
+		if (threads > 0) {
+			return threads;
+		}
+		return std::max(1, int(std::thread::hardware_concurrency()));
+	}
+
+	// Counts the leaf nodes of the position, depth may be zero
+	uint64_t Perft::subtree(int depth) {
+		if (depth <= 0) {
+			return 1ULL;
+		}
+		return pseudoLegal ? search<true>(depth) : search<false>(depth);
+	}
+
+	// Splits the tree into the subtrees below every reply to every root move, which are handed
+	// out in order to threads as they become free. Splitting at the second ply gives a few
+	// hundred tasks, so one large root move does not leave the other threads idle
+	void Perft::divideParallel(int depth, const MovePoint rootMoves[], int numRootMoves, uint64_t rootNodes[]) {
+		struct Task {
+			int root{};
+			Move reply{};
+		};
+
+		std::vector<Task> tasks;
+		for (int i = 0; i < numRootMoves; ++i) {
+			MovePoint replies[MoveGen::maxMoves];
+			board->makeMove(rootMoves[i].move);
+			int numReplies = pseudoLegal ? generate<true>(replies) : generate<false>(replies);
+			board->unMakeMove();
+
+			for (int j = 0; j < numReplies; ++j) {
+				tasks.push_back({ i, replies[j].move });
+			}
+		}
+
+		std::vector<uint64_t> taskNodes(tasks.size(), 0ULL);
+		std::atomic<std::size_t> nextTask{ 0 };
+
+		auto work = [&]() {
+			Board workerBoard(*board);
+			Perft worker(&workerBoard);
+			worker.table = table;
+			worker.pseudoLegal = pseudoLegal;
+
+			for (std::size_t t = nextTask++; t < tasks.size(); t = nextTask++) {
+				workerBoard.makeMove(rootMoves[tasks[t].root].move);
+				workerBoard.makeMove(tasks[t].reply);
+				taskNodes[t] = worker.subtree(depth - 2);
+				workerBoard.unMakeMove();
+				workerBoard.unMakeMove();
+			}
+		};
+
+		std::vector<std::thread> workers;
+		for (int i = 1; i < threadCount(); ++i) {
+			workers.emplace_back(work);
+		}
+		work();
+
+		for (std::thread& worker : workers) {
+			worker.join();
+		}
+
+		std::fill(rootNodes, rootNodes + numRootMoves, 0ULL);
+		for (std::size_t t = 0; t < tasks.size(); ++t) {
+			rootNodes[tasks[t].root] += taskNodes[t];
+		}
+	}
+
+	// Counts leaf nodes recursively, the last ply is counted from the number of generated moves.
+	// The table is probed before moves are generated, so a hit skips move generation
+	template <bool PseudoLegal>
+	uint64_t Perft::search(int depth) {
+		HashKey hash = board->state->zobristHash;
+		uint64_t nodes{ 0ULL };
+		if (depth > 1 && !table->empty() && table->probe(hash, depth, nodes)) {
+			return nodes;
+		}
+
+		MovePoint moves[MoveGen::maxMoves];
+		int numMoves = generate<PseudoLegal>(moves);
+
+		if (depth == 1) {
+			return numMoves;
+		}
+
+		for (int i = 0; i < numMoves; ++i) {
+			board->makeMove(moves[i].move);
+			nodes += search<PseudoLegal>(depth - 1);
+			board->unMakeMove();
+		}
+
+		if (!table->empty()) {
+			table->store(hash, depth, nodes);
+		}
+		return nodes;
+	}
+
+	// Generates the legal moves of the position. Pseudo legal moves are filtered in place
+	template <bool PseudoLegal>
+	int Perft::generate(MovePoint moves[]) {
+		if constexpr (!PseudoLegal) {
+			return moveGenerator.generate(moves);
+		} else {
+			int numMoves = moveGenerator.generate<PSEUDO_LEGAL>(moves);
+			int numLegal = 0;
+			for (int i = 0; i < numMoves; ++i) {
+				if (board->isLegal(moves[i].move)) {
+					moves[numLegal++] = moves[i];
+				}
+			}
+			return numLegal;
+		}
+	}
+
+}
@@ -0,0 +1,193 @@
+#include "SandalBotC.h"
+
+#include "Engine.h"
+#include "Evaluator.h"
+#include "FEN.h"
+#include "StringUtil.h"
+#include "UCIListener.h"
+
+#include <cstring>
+#include <exception>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace SandalBot;
+
+struct sandalbot_engine {
+	Engine engine;
+
+	sandalbot_engine(const EngineOptions& options) : engine(options) {}
+};
+
+struct sandalbot_table {
+	std::shared_ptr<TranspositionTable> table;
+};
+
+namespace {
+
+	SearchRequest toRequest(const sandalbot_limits* limits) {
+		SearchRequest request;
+		if (limits != nullptr) {
+			request.moveTimeMs = limits->move_time_ms;
+			request.depth = limits->depth;
+			request.nodes = limits->nodes;
+			request.mate = limits->mate;
+			request.multiPV = limits->multi_pv > 0 ? limits->multi_pv : 1;
+		}
+		return request;
+	}
+
+	// Copies a move in UCI notation into a buffer of six characters, a null move is left empty
+	void copyMove(Move move, char (&buffer)[6]) {
+		std::string text = move == Move() ? "" : UCIListener::uciMove(move);
+		std::strncpy(buffer, text.c_str(), sizeof(buffer) - 1);
+		buffer[sizeof(buffer) - 1] = '\0';
+	}
+
+	sandalbot_result toResult(const SearchResult& searchResult) {
+		sandalbot_result result{};
+		copyMove(searchResult.bestMove, result.best_move);
+		copyMove(searchResult.ponderMove, result.ponder_move);
+
+		int movesRemaining = Evaluator::movesTilMate(searchResult.eval);
+		if (movesRemaining != 0) {
+			result.mate = searchResult.eval >= 0 ? movesRemaining : -movesRemaining;
+		} else {
+			result.score_cp = searchResult.eval;
+		}
+		result.depth = searchResult.depth;
+		result.nodes = searchResult.nodes;
+		return result;
+	}
+
+}
+
+extern "C" {
+
+	sandalbot_table* sandalbot_table_create(int size_mb) {
+		try {
+			return new sandalbot_table{ Engine::createTable(size_mb) };
+		} catch (const std::exception&) {
+			return nullptr;
+		}
+	}
+
+	void sandalbot_table_release(sandalbot_table* table) {
+		delete table;
+	}
+
+	sandalbot_engine* sandalbot_engine_create(int hash_size_mb, sandalbot_table* shared_table) {
+		try {
+			EngineOptions options;
+			options.hashSizeMB = hash_size_mb;
+			if (shared_table != nullptr) {
+				options.sharedTable = shared_table->table;
+			}
+			return new sandalbot_engine(options);
+		} catch (const std::exception&) {
+			return nullptr;
+		}
+	}
+
+	void sandalbot_engine_destroy(sandalbot_engine* engine) {
+		try {
+			delete engine;
+		} catch (const std::exception&) {
+		}
+	}
+
+	int sandalbot_engine_new_game(sandalbot_engine* engine) {
+		if (engine == nullptr) {
+			return SANDALBOT_ERROR;
+		}
+		try {
+			engine->engine.newGame();
+			return SANDALBOT_OK;
+		} catch (const std::exception&) {
+			return SANDALBOT_ERROR;
+		}
+	}
+
+	int sandalbot_engine_set_position(sandalbot_engine* engine, const char* fen, const char* moves) {
+		if (engine == nullptr) {
+			return SANDALBOT_ERROR;
+		}
+		try {
+			std::string_view position = fen == nullptr || std::strcmp(fen, "startpos") == 0 ? FEN::startpos : fen;
+			std::vector<std::string> moveList = moves == nullptr ? std::vector<std::string>() : StringUtil::splitString(moves);
+			return engine->engine.setPosition(position, moveList) ? SANDALBOT_OK : SANDALBOT_ERROR;
+		} catch (const std::exception&) {
+			return SANDALBOT_ERROR;
+		}
+	}
+
+	int sandalbot_engine_make_move(sandalbot_engine* engine, const char* move) {
+		if (engine == nullptr || move == nullptr) {
+			return SANDALBOT_ERROR;
+		}
+		try {
+			return engine->engine.makeMove(move) ? SANDALBOT_OK : SANDALBOT_ERROR;
+		} catch (const std::exception&) {
+			return SANDALBOT_ERROR;
+		}
+	}
+
+	int sandalbot_engine_search(sandalbot_engine* engine, const sandalbot_limits* limits, sandalbot_result* result) {
+		if (engine == nullptr) {
+			return SANDALBOT_ERROR;
+		}
+		try {
+			sandalbot_result searchResult = toResult(engine->engine.search(toRequest(limits)));
+			if (result != nullptr) {
+				*result = searchResult;
+			}
+			return SANDALBOT_OK;
+		} catch (const std::exception&) {
+			return SANDALBOT_ERROR;
+		}
+	}
+
+	int sandalbot_engine_search_async(sandalbot_engine* engine, const sandalbot_limits* limits,
+		sandalbot_callback callback, void* user_data) {
+		if (engine == nullptr) {
+			return SANDALBOT_ERROR;
+		}
+		try {
+			engine->engine.searchAsync(toRequest(limits), [callback, user_data](const SearchResult& searchResult) {
+				if (callback != nullptr) {
+					sandalbot_result result = toResult(searchResult);
+					callback(&result, user_data);
+				}
+			});
+			return SANDALBOT_OK;
+		} catch (const std::exception&) {
+			return SANDALBOT_ERROR;
+		}
+	}
+
+	int sandalbot_engine_stop(sandalbot_engine* engine) {
+		if (engine == nullptr) {
+			return SANDALBOT_ERROR;
+		}
+		try {
+			engine->engine.stop();
+			return SANDALBOT_OK;
+		} catch (const std::exception&) {
+			return SANDALBOT_ERROR;
+		}
+	}
+
+	int sandalbot_engine_wait(sandalbot_engine* engine) {
+		if (engine == nullptr) {
+			return SANDALBOT_ERROR;
+		}
+		try {
+			engine->engine.wait();
+			return SANDALBOT_OK;
+		} catch (const std::exception&) {
+			return SANDALBOT_ERROR;
+		}
+	}
+
+}
@@ -0,0 +1,59 @@
+#include "SearchThread.h"
+
+#include <utility>
+
+using namespace std;
+
+namespace SandalBot {
+
+	SearchThread::SearchThread() : thread(&SearchThread::idleLoop, this) {}
+
+	// Waits for the running job and exits the thread
+	SearchThread::~SearchThread() {
+		{
+			lock_guard<std::mutex> lock{ mutex };
+			exiting = true;
+		}
+		jobChanged.notify_all();
+		thread.join();
+	}
+
+	// Runs job on the search thread, waiting first for any job already running
+	void SearchThread::start(function<void()> job) {
+		unique_lock<std::mutex> lock{ mutex };
+		jobChanged.wait(lock, [this] { return !this->job; });
+		this->job = std::move(job);
+		lock.unlock();
+		jobChanged.notify_all();
+	}
+
+	// Blocks until the search thread is parked
+	void SearchThread::wait() {
+		unique_lock<std::mutex> lock{ mutex };
+		jobChanged.wait(lock, [this] { return !job; });
+	}
+
+	bool SearchThread::searching() {
+		lock_guard<std::mutex> lock{ mutex };
+		return bool(job);
+	}
+
+	// Parks until a job is posted, runs it, and clears it to signal waiting threads
+	void SearchThread::idleLoop() {
+		unique_lock<std::mutex> lock{ mutex };
+		while (true) {
+			jobChanged.wait(lock, [this] { return job || exiting; });
+			if (!job) {
+				return;
+			}
+
+			lock.unlock();
+			job();
+			lock.lock();
+
+			job = nullptr;
+			jobChanged.notify_all();
+		}
+	}
+
+}
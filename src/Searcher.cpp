@@ -1,10 +1,12 @@
 #include "Searcher.h"
 
+#include "PerfCounters.h"
+
+#include <algorithm>
 #include <atomic>
 #include <chrono>
 #include <iomanip>
-#include <iostream>
-#include <thread>
+#include <sstream>
 #include <string>
 #include <string_view>
 
@@ -14,14 +16,21 @@ namespace SandalBot {
 
 	using namespace std::literals::string_view_literals;
 
-	// Constructor initialised with board
+	// Constructor initialised with board, searching with a table of the default size
 	Searcher::Searcher(Board* board) : board(board) {
 		// Allocate member variables
 		this->moveGenerator = MoveGen(board);
 		this->orderer = MoveOrderer();
 		this->evaluator = Evaluator();
-		this->tTable = TranspositionTable();
 		this->bestLine = MoveLine(bestLineSize);
+		this->linePV = MoveLine(bestLineSize);
+	}
+
+	// Constructor initialised with board and a table, which may be shared with other searchers
+	Searcher::Searcher(Board* board, std::shared_ptr<TranspositionTable> table) : board(board), tTable(std::move(table)) {
+		this->moveGenerator = MoveGen(board);
+		this->bestLine = MoveLine(bestLineSize);
+		this->linePV = MoveLine(bestLineSize);
 	}
 
 	// Performs iterative deepening, iteratively searches deeper and deeper for more intelligent
@@ -31,6 +40,9 @@ namespace SandalBot {
 		// Initialise moves and statistics of search
 		bestMove = Move();
 		currentMove = Move();
+		bestLine.reset();
+		searchNodes = 0ULL;
+		uint64_t previousNodes = 0ULL;
 		SearchStatistics temp;
 
 		// If board position is illegal, do not search
@@ -38,38 +50,88 @@ namespace SandalBot {
 			return;
 		}
 
+		// Lines are limited by the root moves which may be searched
+		MovePoint rootMoves[MoveGen::maxMoves];
+		int numRootMoves = moveGenerator.generate(rootMoves);
+		if (!searchMoves.empty()) {
+			numRootMoves = restrictRootMoves(rootMoves, numRootMoves);
+		}
+		lineCount = max(1, min(multiPV, numRootMoves));
+		lines.clear();
+
 		// Perform search for each depth until maximum depth
-		for (int depth = 1; depth < maxDeepening; depth++) {
+		for (int depth = 1; depth < maxDeepening && depth <= depthLimit; depth++) {
 			// Peform negamax search of position and time it
 			auto start = chrono::high_resolution_clock::now();
 			stats = SearchStatistics();
+			evaluator.resetStatistics();
+			ttCounters = TranspositionTable::ProbeCounters();
 			int eval = negaMax(defaultAlpha, defaultBeta, 0, depth, 0);
+			// The first line searches every move, so it is the iteration's result even if search is
+			// cancelled while later lines are searched
+			bool completed = !cancelSearch.load();
+			if (completed) {
+				bestLine.reset();
+				generateBestLine(currentMove, bestLine);
+				bestMove = currentMove;
+				searchOtherLines(depth, eval);
+				// The best move is the best scoring line, so bestmove always matches the first line reported
+				if (lines[0].move != bestMove) {
+					bestMove = lines[0].move;
+					eval = lines[0].eval;
+					bestLine.reset();
+					for (Move move : lines[0].pv) {
+						bestLine.add(move);
+					}
+				}
+			}
 			auto end = chrono::high_resolution_clock::now();
 			chrono::duration<uint64_t, nano> duration = end - start;
+			searchNodes += stats.nNodes + stats.qNodes;
+
+			// Gather counters kept by the evaluator and transposition table during the iteration
+			stats.lazyExits = evaluator.lazyExits;
+			stats.lazyProbes = evaluator.lazyProbes;
+			stats.ttProbes = ttCounters.probes;
+			stats.ttHits = ttCounters.hits;
+			stats.ttCutoffs = ttCounters.cutoffs;
+			stats.ttCollisions = ttCounters.collisions;
+			if (previousNodes != 0ULL) {
+				stats.branchingFactor = double(stats.nNodes + stats.qNodes) / double(previousNodes);
+			}
+			previousNodes = stats.nNodes + stats.qNodes;
 
 			// If search is not cancelled, update stats
-			if (!cancelSearch.load()) {
-				bestLine.reset();
-				generateBestLine(std::move(currentMove));
-				bestMove = currentMove;
+			if (completed) {
 				temp = stats;
-				temp.bestMove = currentMove;
+				temp.bestMove = bestMove;
 				temp.depth = depth;
 				temp.eval = eval;
 				temp.duration = duration.count();
 
-				temp.print(this);
+				if (reportIterations && listener != nullptr) {
+					listener->onIteration(temp.report(this));
+					if (statsFormat != StatsFormat::OFF) {
+						listener->onInfo(temp.statsString(statsFormat));
+					}
+				}
 			}
 			// If search is cancelled, stop iterative deepening
 			if (cancelSearch.load()) {
 				break;
 			} 
-			// If checkmate has been found, stop search early
-			else if (Evaluator::isMateScore(eval)) {
+			// If checkmate has been found, stop search early. With a mate limit only a short enough
+			// mate for the side to move ends search, as a longer mate may be shortened by deeper iterations
+			else if (mateLimit == 0 ? Evaluator::isMateScore(eval) : eval > 0 && Evaluator::movesTilMate(eval) != 0
+				&& Evaluator::movesTilMate(eval) <= mateLimit) {
 				searchCompleted.store(true);
 				searchStop.notify_all();
 				break;
 			}
+			// If the next iteration is unlikely to finish within the allotted time, stop search early
+			else if (timeManager.stopAfterIteration(bestMove, eval)) {
+				break;
+			}
 		}
 		// If search ended before it was cancelled, notify other threads
 		if (!cancelSearch.load() && !searchCompleted.load()) {
@@ -77,6 +139,11 @@ namespace SandalBot {
 			searchStop.notify_all();
 		}
 
+		// A search stopped before its first iteration completed still plays a legal move
+		if (bestMove == Move() && numRootMoves > 0) {
+			bestMove = rootMoves[0].move;
+		}
+
 		// Update stats
 		stats = temp;
 	}
@@ -85,10 +152,13 @@ namespace SandalBot {
 	// reduces horizon effect by preventing incredibly inaccurate evaluations from capture
 	// sequences
 	int Searcher::quiescenceSearch(int alpha, int beta, int maxDepth) {
-		stats.qNodes++; // Update stats
 		if (cancelSearch) {
 			return Evaluator::cancelledScore;
 		}
+		stats.qNodes++; // Update stats
+		if (--nodesUntilPoll == 0ULL) {
+			checkLimits();
+		}
 
 		// Check for threefold repetition
 		if (board->history.contains(board->state->zobristHash)) {
@@ -100,17 +170,19 @@ namespace SandalBot {
 		}
 
 		// If position has been previously stored, use its evaluation
-		int tTableEval = tTable.lookup(0, maxDepth, alpha, beta, board->state->zobristHash);
+		int tTableEval = tTable->lookup(0, maxDepth, alpha, beta, board->state->zobristHash, ttCounters);
 		if (tTableEval != TranspositionTable::notFound) {
 			return tTableEval;
 		}
 
 		int score{ 0 };
-		// Evaluate board
-		score = evaluator.Evaluate(board);
+		// Evaluate board, exiting early if material alone is far outside the window
+		score = evaluator.Evaluate(board, alpha, beta);
+		stats.standPatProbes++;
 
 		// If evaluation is too good, cut search
 		if (score >= beta) {
+			stats.standPats++;
 			return beta;
 		}
 
@@ -122,11 +194,11 @@ namespace SandalBot {
 		MovePoint moves[218];
 
 		// Generate moves which only take pieces
-		int numMoves = moveGenerator.generate(moves, true);
+		int numMoves = moveGenerator.generate<CAPTURES>(moves);
 
 		// Order the moves
 		if (numMoves > 1) {
-			orderer.order(board, &moveGenerator, moves, bestMove, numMoves, 0, true);
+			orderer.order(board, moves, bestMove, numMoves, 0, true);
 		}
 
 		for (int i = 0; i < numMoves; i++) {
@@ -158,10 +230,13 @@ namespace SandalBot {
 	// Negamax recursively searches future positions using alpha-beta pruning and
 	// several heuristics to reduce search space
 	int Searcher::negaMax(int alpha, int beta, int depth, int maxDepth, int numExtensions) {
-		stats.nNodes++;
 		if (cancelSearch) {
 			return Evaluator::cancelledScore;
 		}
+		stats.nNodes++;
+		if (--nodesUntilPoll == 0ULL) {
+			checkLimits();
+		}
 
 		if (depth > 0) {
 			// Check for threefold repetition
@@ -184,20 +259,30 @@ namespace SandalBot {
 			}
 		}
 
+		// Root searches restricted to some moves neither use nor store table entries of the root, which
+		// hold results over every move
+		bool restrictedRoot = depth == 0 && (!searchMoves.empty() || !excludedRootMoves.empty());
 		// Lookup position to see if it has been searched and stored in hashtable before
-		int tTableEval = tTable.lookup(maxDepth - depth, depth, alpha, beta, board->state->zobristHash);
+		int tTableEval = restrictedRoot ? TranspositionTable::notFound
+			: tTable->lookup(maxDepth - depth, depth, alpha, beta, board->state->zobristHash, ttCounters);
 		// If position found in transposition hash table, use previous evaluation
 		if (tTableEval != TranspositionTable::notFound) {
-			int tTableDepth = tTable.getDepth(board->state->zobristHash);
+			int tTableDepth = tTable->getDepth(board->state->zobristHash);
 			if (tTableDepth > stats.seldepth && tTableDepth != -1) {
 				stats.seldepth = tTableDepth;
 			}
 
-			if (depth == 0) {
-				currentMove = tTable.getBestMove(board->state->zobristHash);
+			if (depth != 0) {
+				return tTableEval;
 			}
 
-			return tTableEval;
+			// The root entry is only used with a legal move, a searcher sharing the table may have
+			// replaced it since the lookup, otherwise the root is searched
+			Move tableMove = tTable->getBestMove(board->state->zobristHash);
+			if (tableMove.moveValue != 0 && board->isPseudoLegal(tableMove) && board->isLegal(tableMove)) {
+				currentMove = tableMove;
+				return tTableEval;
+			}
 		}
 
 		// If maximum depth is achieved, perform quiescence search
@@ -216,30 +301,55 @@ namespace SandalBot {
 		// Initialise array for moves (218 is maximum number of moves)
 		MovePoint moves[218];
 		// Generate moves and store them inside moves[]
-		int numMoves = moveGenerator.generate(moves);
-		bool isCheck = moveGenerator.isCheck;
+		int numMoves = pseudoLegal ? moveGenerator.generate<PSEUDO_LEGAL>(moves) : moveGenerator.generate(moves);
+		if (restrictedRoot) {
+			numMoves = restrictRootMoves(moves, numMoves);
+		}
+		int searchedMoves = 0; // Number of legal moves searched
 		bool worthExtension = false;
 		// Get best move (whether it be bestMove from iterative deepening or previous transpositions)
-		Move currentBestMove = depth == 0 ? std::move(this->bestMove) : tTable.getBestMove(board->state->zobristHash);
+		Move currentBestMove = depth == 0 ? std::move(this->bestMove) : tTable->getBestMove(board->state->zobristHash);
+		// Checks are found once per node before ordering, as each child search replaces the board's
+		// attack information, and the move loop reuses them
+		const AttackInfo& checkInfo = board->checkInfo();
+		for (int i = 0; i < numMoves; ++i) {
+			moves[i].givesCheck = board->givesCheck(moves[i].move, checkInfo);
+		}
 		// Order moves to heuristically narrow search
-		orderer.order(board, &moveGenerator, moves, currentBestMove, numMoves, depth, false);
+		orderer.order(board, moves, currentBestMove, numMoves, depth, false);
 
 		for (int i = 0; i < numMoves; ++i) {
+			// Pseudo legal moves are only checked once they are reached, after earlier moves failed to cut off
+			if (pseudoLegal && !board->isLegal(moves[i].move)) {
+				continue;
+			}
+			int moveIndex = searchedMoves++;
+			if (depth == 0 && reportIterations && listener != nullptr) {
+				listener->onCurrentMove(maxDepth, moves[i].move, moveIndex + 1, uint64_t(timeManager.elapsed()));
+			}
+			// Checks are found before making the move, so checking moves are extended and never reduced
+			bool givesCheck = moves[i].givesCheck;
+
 			// Make move
 			board->makeMove(moves[i].move);
 			bool fullSearch = true;
 			int extension = 0;
-			worthExtension = worthSearching(moves[i].move, isCheck, numExtensions);
+			worthExtension = worthSearching(moves[i].move, givesCheck, numExtensions);
+			bool reducible = !worthExtension && !givesCheck;
 			// Reduce depth for moves late in move order as they are unlikely to be good
 			
-			if (i >= 4 * reduceExtensionCutoff && (maxDepth - depth) >= 3 && !worthExtension) {
+			if (moveIndex >= 4 * reduceExtensionCutoff && (maxDepth - depth) >= 3 && reducible) {
+				stats.reductions++;
 				score = -negaMax(-beta, -alpha, depth + 1, maxDepth - 2, numExtensions);
 				// If move is good do full search
 				fullSearch = score > alpha;
-			} else if (i >= reduceExtensionCutoff && (maxDepth - depth) >= 2 && !worthExtension) {
+				stats.reSearches += fullSearch;
+			} else if (moveIndex >= reduceExtensionCutoff && (maxDepth - depth) >= 2 && reducible) {
+				stats.reductions++;
 				score = -negaMax(-beta, -alpha, depth + 1, maxDepth - 1, numExtensions);
 				// If move is good do full search
 				fullSearch = score > alpha;
+				stats.reSearches += fullSearch;
 			}
 			// If move is worth searching more, increase maxdepth for move
 			if (worthExtension) {
@@ -269,8 +379,13 @@ namespace SandalBot {
 			}
 
 			if (alpha >= beta) {
+				stats.betaCutoffs++;
+				stats.firstMoveCutoffs += moveIndex == 0;
+				stats.cutoffIndexSum += moveIndex;
 				// Store position
-				tTable.store(beta, maxDepth + extension - depth, depth, TranspositionTable::lowerBound, moves[i].move, board->state->zobristHash);
+				if (!restrictedRoot) {
+					tTable->store(beta, maxDepth + extension - depth, depth, TranspositionTable::lowerBound, moves[i].move, board->state->zobristHash);
+				}
 				// Update killer moves
 				orderer.addKiller(depth, moves[i].move);
 				return beta;
@@ -278,136 +393,236 @@ namespace SandalBot {
 		}
 
 		// If no moves, either checkmate or stalemate
-		if (numMoves == 0) {
+		if (searchedMoves == 0) {
 			int eval = Evaluator::drawScore;
 			if (moveGenerator.isCheck) {
 				eval = -(Evaluator::checkMateScore - depth);
 			}
 			// Store move
-			tTable.store(eval, maxDepth - depth, depth, TranspositionTable::exact, nullMove, board->state->zobristHash);
+			tTable->store(eval, maxDepth - depth, depth, TranspositionTable::exact, nullMove, board->state->zobristHash);
 			return eval;
 		}
 
 		// Store move
-		tTable.store(alpha, greaterAlpha ? bestDepth - depth : maxDepth - depth, depth, evalBound, greaterAlpha ? currentBestMove : nullMove, board->state->zobristHash);
+		if (!restrictedRoot) {
+			tTable->store(alpha, greaterAlpha ? bestDepth - depth : maxDepth - depth, depth, evalBound, greaterAlpha ? currentBestMove : nullMove, board->state->zobristHash);
+		}
 
 		return alpha;
 	}
 
-	// Movesearch purely searches using recursion. Used for perft command to test move generation
-	uint64_t Searcher::moveSearch(int depth, int maxDepth) {
-		if (depth == maxDepth) {
-			return 1ULL;
+	// Cancels search once the maximum time is up or the node limit is reached, and schedules the next
+	// check so that a node limit is met exactly
+	void Searcher::checkLimits() {
+		// A ponder search keeps going on ponderhit, with the time limits of its go command
+		if (ponderSearch && !timedSearch && ponderHitReceived.load()) {
+			startAllottedTime();
+			timedSearch = true;
 		}
 
-		// Generate moves
-		uint64_t movesGenerated = 0ULL;
+		uint64_t nodes = searchNodes + stats.nNodes + stats.qNodes;
+		if (nodes >= nodeLimit || (timedSearch && timeManager.outOfTime())) {
+			cancelSearch.store(true);
+		}
+		nodesUntilPoll = min(pollInterval, nodeLimit > nodes ? nodeLimit - nodes : pollInterval);
+	}
 
-		MovePoint moves[218];
+	// Starts the search for a fixed move time, or until stopped if untimed
+	void Searcher::startSearch(bool isTimed, int moveTimeMs) {
+		if (isTimed) {
+			timeManager.initFixed(moveTimeMs);
+		} else {
+			timeManager.initInfinite();
+		}
+		runSearch(isTimed);
+	}
 
-		int numMoves = moveGenerator.generate(moves);
-		for (int i = 0; i < numMoves; ++i) {
-			uint64_t numMoves{ 0ULL }; // Tracks number of nodes found in perft
-			// Simulate move
-			board->makeMove(moves[i].move);
-			numMoves += moveSearch(depth + 1, maxDepth);
-			board->unMakeMove();
+	// Starts the search with time allotted from the clock of the side to move
+	void Searcher::startClockSearch(int timeMs, int incMs, int movesToGo) {
+		timeManager.initClock(timeMs, incMs, movesToGo);
+		if (reportIterations && listener != nullptr) {
+			listener->onInfo("time optimum " + to_string(timeManager.optimum()) + " maximum " + to_string(timeManager.maximum()));
+		}
+		runSearch(true);
+	}
 
-			// If at depth 0, print number of moves from branch, useful for debugging
-			if (depth == 0) {
-				std::string_view promotionpiece = "";
-				switch (moves[i].move.flag()) {
-				case Move::Flag::QUEEN:
-					promotionpiece = "q"sv;
-					break;
-				case Move::Flag::ROOK:
-					promotionpiece = "r"sv;
-					break;
-				case Move::Flag::BISHOP:
-					promotionpiece = "b"sv;
-					break;
-				case Move::Flag::KNIGHT:
-					promotionpiece = "n"sv;
-					break;
-				}
-				cout << CoordHelper::indexToString(moves[i].move.from()) 
-				<< CoordHelper::indexToString(moves[i].move.to()) 
-				<< promotionpiece << ": " << numMoves << endl;
+	// Searches the position after the expected reply until stopped or until ponderhit, from which
+	// the search continues with time allotted from the given limits. The table and move ordering
+	// state built while pondering are kept, as the search is never restarted
+	void Searcher::startPonderSearch(int timeMs, int incMs, int movesToGo, int moveTimeMs) {
+		ponderLimits = { timeMs, incMs, movesToGo, moveTimeMs };
+		ponderSearch = true;
+		timeManager.initInfinite();
+		runSearch(false);
+		ponderSearch = false;
+	}
+
+	// The opponent played the expected reply, so the ponder search becomes the real search. Called
+	// from another thread, the search switches to timed search at its next poll
+	void Searcher::ponderHit() {
+		{
+			lock_guard<mutex> lock{ searchMutex };
+			ponderHitReceived.store(true);
+		}
+		searchStop.notify_all();
+	}
+
+	// Allots time for the ponder search from the moment of ponderhit
+	void Searcher::startAllottedTime() {
+		if (ponderLimits.moveTimeMs > 0) {
+			timeManager.initFixed(ponderLimits.moveTimeMs);
+		} else {
+			timeManager.initClock(ponderLimits.timeMs, ponderLimits.incMs, ponderLimits.movesToGo);
+		}
+		if (reportIterations && listener != nullptr) {
+			listener->onInfo("time optimum " + to_string(timeManager.optimum()) + " maximum " + to_string(timeManager.maximum()));
+		}
+	}
+
+	// Searches on the calling thread, which checks the clock and node limit itself. A search without
+	// a time, depth, node or mate limit does not return until it is stopped or, when pondering, until
+	// ponderhit, even if it completed early
+	void Searcher::runSearch(bool isTimed) {
+		beginSearch();
+		timedSearch = isTimed;
+		nodesUntilPoll = min(pollInterval, nodeLimit);
+
+		PerfCounters counters;
+		if (perfCounters) {
+			counters.start();
+		}
+
+		iterativeSearch();
+
+		// A ponder search which completed before ponderhit has nothing left to do once it arrives
+		bool limited = depthLimit < maxDeepening || nodeLimit != numeric_limits<uint64_t>::max() || mateLimit > 0;
+		if (!isTimed && (ponderSearch || !limited)) {
+			unique_lock<mutex> lock{ searchMutex }; // Lock for searchStop
+			searchStop.wait(lock, [this] { return this->cancelSearch.load() || (ponderSearch && ponderHitReceived.load()); });
+		}
+		ponderHitReceived.store(false);
+
+		if (perfCounters) {
+			counters.stop();
+			if (listener != nullptr) {
+				ostringstream report;
+				counters.report(report, searchNodes);
+				listener->onInfo(report.str());
 			}
-			movesGenerated += numMoves;
 		}
-		return movesGenerated;
 	}
 
-	// Sleeps recursively until search has completed or until moveTimeMs is up
-	void Searcher::moveSleep(int moveTimeMs) {
-		chrono::milliseconds runDurationMs{ moveTimeMs };
-		auto stopTime = chrono::duration_cast<chrono::milliseconds>(chrono::system_clock::now().time_since_epoch()).count();
-		stopTime += runDurationMs.count();
-
-		// While search is ongoing, sleep until search completed or current time is exceeded stop time
-		while (!searchCompleted.load()) {
-			this_thread::sleep_for(chrono::milliseconds(searchWaitPeriod));
-			auto now = chrono::duration_cast<chrono::milliseconds>(chrono::system_clock::now().time_since_epoch()).count();
-			if (now > stopTime) {
+	// Removes root moves which are not search moves, or which belong to earlier lines of the
+	// iteration, keeping the order of the rest
+	int Searcher::restrictRootMoves(MovePoint moves[], int numMoves) {
+		int numKept = 0;
+		for (int i = 0; i < numMoves; i++) {
+			Move move = moves[i].move;
+			bool searched = searchMoves.empty() || find(searchMoves.begin(), searchMoves.end(), move) != searchMoves.end();
+			bool excluded = find(excludedRootMoves.begin(), excludedRootMoves.end(), move) != excludedRootMoves.end();
+			if (searched && !excluded) {
+				moves[numKept++] = moves[i];
+			}
+		}
+		return numKept;
+	}
+
+	// Records the first line of the iteration, then searches the root again for each further line
+	// without the moves of the lines found so far. If search is cancelled, the lines completed
+	// before it are kept. Reductions and table entries differ between the searches, so a later line
+	// may score above an earlier one, and lines are ordered by score once all are searched
+	void Searcher::searchOtherLines(int depth, int eval) {
+		vector<RootLine> iterationLines{ { bestMove, eval, bestLine.moves() } };
+
+		for (int line = 1; line < lineCount; line++) {
+			excludedRootMoves.push_back(iterationLines.back().move);
+			int lineEval = negaMax(defaultAlpha, defaultBeta, 0, depth, 0);
+			if (cancelSearch.load()) {
 				break;
 			}
+
+			linePV.reset();
+			generateBestLine(currentMove, linePV);
+			iterationLines.push_back({ currentMove, lineEval, linePV.moves() });
 		}
+		excludedRootMoves.clear();
+		stable_sort(iterationLines.begin(), iterationLines.end(), [](const RootLine& a, const RootLine& b) { return a.eval > b.eval; });
+		lines = std::move(iterationLines);
+	}
 
-		// Notify other threads that search is over
-		cancelSearch.store(true);
-		searchStop.notify_all();
+	// Sets the limits of following searches, replacing those of the previous go command
+	void Searcher::setLimits(const SearchLimits& limits) {
+		depthLimit = limits.depth > 0 ? min(limits.depth, int(maxDeepening)) : maxDeepening;
+		setNodeLimit(limits.nodes);
+		mateLimit = limits.mate;
+		searchMoves = limits.searchMoves;
 	}
 
-	// Starts the search on separate thread until time limit up
-	void Searcher::startSearch(bool isTimed, int moveTimeMs) {
+	// Searches on the calling thread until depth is completed or mate is found, used where
+	// results must not depend on timing
+	void Searcher::searchToDepth(int depth) {
+		beginSearch();
+		timeManager.initInfinite();
+		timedSearch = false;
+		nodesUntilPoll = min(pollInterval, nodeLimit);
+		int previousDepthLimit = depthLimit;
+		depthLimit = depth;
+
+		iterativeSearch();
+
+		depthLimit = previousDepthLimit;
+	}
+
+	// Clears the flags of the previous search before the next one is handed to another thread, so
+	// a stop sent once the search is posted ends it even if the search thread has not started it yet.
+	// Must not be called while a search is running
+	void Searcher::prepareSearch() {
+		lock_guard<mutex> lock{ searchMutex };
 		cancelSearch.store(false);
 		searchCompleted.store(false);
-		unique_lock<mutex> lock{ searchMutex }; // Lock for searchStop
-
-		thread searchThread(&Searcher::iterativeSearch, this); // Begin search
-		thread timerThread;
-		// If search is timed, create thread which interrupts upon time limit
-		if (isTimed) {
-			timerThread = thread(&Searcher::moveSleep, this, moveTimeMs);
-		}
-		// Wait until search has completed (notified by either previous thread)
-		searchStop.wait(lock, [this] { return this->cancelSearch.load(); });
+		searchPrepared.store(true);
+	}
 
-		// Join previous threads
-		if (isTimed) {
-			timerThread.join();
+	// Clears the flags of the previous search, unless prepareSearch already has and a stop may
+	// have arrived since
+	void Searcher::beginSearch() {
+		if (!searchPrepared.exchange(false)) {
+			cancelSearch.store(false);
+			searchCompleted.store(false);
 		}
-
-		searchThread.join();
 	}
 
 	// Cancels search
 	void Searcher::endSearch() {
-		searchCompleted.store(true);
-		cancelSearch.store(true);
+		{
+			// Held while cancelling so a search waiting to be stopped cannot miss the notification
+			lock_guard<mutex> lock{ searchMutex };
+			searchCompleted.store(true);
+			cancelSearch.store(true);
+		}
 		searchStop.notify_all();
 	}
 
 	// Determines whether move is worth extending search for
-	bool Searcher::worthSearching(Move move, const bool isCheck, const int numExtensions) {
-		return (move.isPromotion() || isCheck) && numExtensions < maxExtensions;
+	bool Searcher::worthSearching(Move move, const bool givesCheck, const int numExtensions) {
+		return (move.isPromotion() || givesCheck) && numExtensions < maxExtensions;
 	}
 
 	// Generates best line
-	void Searcher::generateBestLine(Move bestMove) {
+	void Searcher::generateBestLine(Move bestMove, MoveLine& line) {
 		int depth = 0;
-		enactBestLine(bestMove, depth); // Begin recursively generating
+		enactBestLine(bestMove, depth, line); // Begin recursively generating
 	}
 
 	// Recursively searches the transposition table for best moves found (principal variation)
 	// of current position
-	void Searcher::enactBestLine(Move move, int depth) {
-		if (move.moveValue == 0) {
+	void Searcher::enactBestLine(Move move, int depth, MoveLine& line) {
+		// Table moves may belong to another position after a hash collision
+		if (move.moveValue == 0 || !board->isPseudoLegal(move) || !board->isLegal(move)) {
 			return;
 		}
 
-		bestLine.add(move); // Add move to bestline list
+		line.add(move); // Add move to bestline list
 
 		// If threefold repetition, stop searching
 		if (board->history.contains(board->state->zobristHash)) {
@@ -416,9 +631,9 @@ namespace SandalBot {
 		// Apply move to board
 		board->makeMove(move);
 		// Acquire next move from transposition table
-		Move nextMove = tTable.getBestMove(board->state->zobristHash);
+		Move nextMove = tTable->getBestMove(board->state->zobristHash);
 
-		enactBestLine(nextMove, depth + 1);
+		enactBestLine(nextMove, depth + 1, line);
 
 		board->unMakeMove(); // Rollback changes to board
 	}
@@ -450,51 +665,65 @@ namespace SandalBot {
 		return evaluator.Evaluate(board);
 	}
 
-	// Deletes old transposition table and creates new one of different size
+	// Replaces the transposition table with a new one of different size, a shared table is left
+	// to the other searchers using it
 	void Searcher::changeHashSize(int sizeMB) {
-		tTable = TranspositionTable(sizeMB);
+		tTable = make_shared<TranspositionTable>(sizeMB);
 	}
 
 	// Clears all transposition table entries
 	void Searcher::clearHash() {
-		tTable.clear();
+		tTable->clear();
 	}
 
-	// Performs perft test
-	uint64_t Searcher::perft(int depth) {
-		return moveSearch(0, depth);
-	}
-
-	// Formats evaluation to string, accounting for checkmate scores as well
-	std::string Searcher::SearchStatistics::prepareEval() {
-		int movesRemaining = Evaluator::movesTilMate(eval);
-		string sign = eval >= 0 ? "" : "-";
-		// If checkmate
-		if (movesRemaining != 0)
-			return "mate " + sign + to_string(movesRemaining);
-
-		return "cp " + to_string(eval); // centipawn eval
-	}
-
-	// Prints statistics of search. Prints in standard UCI format
-	void Searcher::SearchStatistics::print(Searcher* searcher) {
+	// Collects the iteration's results and best lines for the listener
+	IterationReport Searcher::SearchStatistics::report(const Searcher* searcher) const {
 		// Prevent division by zero
-		if (duration == 0)
-			duration = 1;
-
-		string pv = searcher->bestLine.str(); // Principal variation
-		cout << "info depth " << to_string(depth) << " seldepth " << to_string(seldepth);
-		cout << " score " << prepareEval() << " nodes " << to_string(nNodes + qNodes);
-		cout << " nps " << to_string(uint64_t(1000000000ULL * (nNodes + qNodes) / duration));
-		cout << " hashfull " << to_string((int)(1000 * (float)searcher->tTable.slotsFilled / (float)searcher->tTable.size));
-		cout << " time " << to_string(duration / 1000000ULL);
+		uint64_t elapsed = max(duration, uint64_t(1));
+
+		IterationReport report;
+		report.depth = depth;
+		report.seldepth = seldepth;
+		report.nodes = nNodes + qNodes;
+		report.nps = uint64_t(1000000000ULL * (nNodes + qNodes) / elapsed);
+		report.timeMs = duration / 1000000ULL;
+		report.hashfull = searcher->tTable->hashfull();
+		report.lines = searcher->lines;
+		return report;
+	}
 
-		// If principal variation exists, print it
-		if (pv.size() != 0) {
-			cout << " pv " << pv;
+	// Formats counters of the iteration, either as labelled values or as a JSON object
+	std::string Searcher::SearchStatistics::statsString(StatsFormat format) const {
+		if (format == StatsFormat::OFF) {
+			return "";
 		}
 
-		cout << endl;
+		// Percentage of a count, zero if there is nothing to divide by
+		auto percent = [](uint64_t count, uint64_t total) { return total == 0ULL ? 0.0 : 100.0 * double(count) / double(total); };
+		double averageCutoffIndex = betaCutoffs == 0ULL ? 0.0 : double(cutoffIndexSum) / double(betaCutoffs);
+
+		ostringstream out;
+		out << fixed << setprecision(2);
+		if (format == StatsFormat::INFO) {
+			out << "stats depth " << depth;
+			out << " tt probes " << ttProbes << " hits " << percent(ttHits, ttProbes) << "%";
+			out << " cutoffs " << percent(ttCutoffs, ttProbes) << "% collisions " << percent(ttCollisions, ttProbes) << "%";
+			out << " fhf " << percent(firstMoveCutoffs, betaCutoffs) << "% cutoffindex " << averageCutoffIndex;
+			out << " ebf " << branchingFactor;
+			out << " lmr " << reductions << " research " << percent(reSearches, reductions) << "%";
+			out << " standpat " << percent(standPats, standPatProbes) << "%";
+			out << " lazyeval exits " << lazyExits << " of " << lazyProbes;
+		} else {
+			out << "{\"depth\":" << depth << ",\"nodes\":" << (nNodes + qNodes);
+			out << ",\"qNodes\":" << qNodes << ",\"ttProbes\":" << ttProbes << ",\"ttHits\":" << ttHits;
+			out << ",\"ttCutoffs\":" << ttCutoffs << ",\"ttCollisions\":" << ttCollisions;
+			out << ",\"betaCutoffs\":" << betaCutoffs << ",\"firstMoveCutoffs\":" << firstMoveCutoffs;
+			out << ",\"averageCutoffIndex\":" << averageCutoffIndex << ",\"branchingFactor\":" << branchingFactor;
+			out << ",\"reductions\":" << reductions << ",\"reSearches\":" << reSearches;
+			out << ",\"standPats\":" << standPats << ",\"standPatProbes\":" << standPatProbes;
+			out << ",\"lazyExits\":" << lazyExits << ",\"lazyProbes\":" << lazyProbes << "}";
+		}
+		return out.str();
 	}
 
 }
\ No newline at end of file
@@ -12,10 +12,29 @@ namespace SandalBot {
 		std::fill(history, history + allocatedSize, BoardState());
 	}
 
+	StateHistory::StateHistory(const StateHistory& other)
+		: size(other.size), allocatedSize(other.allocatedSize) {
+		history = new BoardState[allocatedSize];
+		std::copy(other.history, other.history + size, history);
+	}
+
 	StateHistory::~StateHistory() {
 		delete[] history;
 	}
 
+	StateHistory& StateHistory::operator=(const StateHistory& other) {
+		if (this != &other) {
+			if (allocatedSize != other.allocatedSize) {
+				delete[] history;
+				allocatedSize = other.allocatedSize;
+				history = new BoardState[allocatedSize];
+			}
+			size = other.size;
+			std::copy(other.history, other.history + size, history);
+		}
+		return *this;
+	}
+
 	// Push new state to history, dynamically adjusts array if memory exceeded
 	void StateHistory::push(const BoardState& state) {
 		// If memory exceeded, double array size and copy elements over
@@ -23,7 +42,7 @@ namespace SandalBot {
 			BoardState* newHistory = new BoardState[2 * allocatedSize];
 			allocatedSize *= 2;
 
-			std::copy(newHistory, newHistory + size, history);
+			std::copy(history, history + size, newHistory);
 
 			delete[] history;
 			history = newHistory;
@@ -0,0 +1,93 @@
+#include "TimeManager.h"
+
+#include "Evaluator.h"
+
+#include <algorithm>
+
+using namespace std;
+
+namespace SandalBot {
+
+	// Allots time from the clock of the side to move. The optimum spreads the remaining time and
+	// expected increments over the moves to go, and the maximum allows several times the optimum
+	// while always keeping a reserve for the following moves and the move overhead
+	void TimeManager::initClock(int timeMs, int incMs, int movesToGo) {
+		start = chrono::steady_clock::now();
+		adaptive = true;
+		previousBestMove = Move();
+		previousEval = 0;
+		iterations = 0;
+		stability = 0;
+
+		int movesLeft = movesToGo > 0 ? min(movesToGo, maxMovesToGo) : defaultMovesToGo;
+		// Time which can be spent without losing on time, after overhead for this and each remaining move
+		int available = max(1, timeMs - moveOverheadMs * min(movesLeft, 3));
+
+		double optimum = double(timeMs) / movesLeft + 0.75 * incMs;
+		// With a single move to go the whole clock belongs to this move
+		double maxShare = movesLeft == 1 ? 0.9 : min(0.8, 0.3 + 0.1 * movesLeft);
+
+		maximumMs = max(1, int(min(optimum * 5.0, available * maxShare)));
+		optimumMs = max(1, min(int(optimum), maximumMs));
+		deadline = start + chrono::milliseconds(maximumMs);
+	}
+
+	// Searches for exactly moveTimeMs, minus the move overhead
+	void TimeManager::initFixed(int moveTimeMs) {
+		start = chrono::steady_clock::now();
+		adaptive = false;
+		maximumMs = max(1, moveTimeMs - moveOverheadMs);
+		optimumMs = maximumMs;
+		deadline = start + chrono::milliseconds(maximumMs);
+	}
+
+	// Searches until stopped or a depth limit is reached
+	void TimeManager::initInfinite() {
+		start = chrono::steady_clock::now();
+		adaptive = false;
+		maximumMs = numeric_limits<int>::max();
+		optimumMs = maximumMs;
+		deadline = chrono::steady_clock::time_point::max();
+	}
+
+	// Milliseconds since the time was allotted
+	int TimeManager::elapsed() const {
+		return int(chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - start).count());
+	}
+
+	// Called after each completed iteration, returns whether another iteration should not be started.
+	// An iteration usually takes longer than all previous iterations together, so one is only started
+	// while less than half of the scaled optimum has elapsed
+	bool TimeManager::stopAfterIteration(Move bestMove, int eval) {
+		if (!adaptive) {
+			return false;
+		}
+
+		double scale = 1.0;
+		if (iterations > 0) {
+			if (bestMove != previousBestMove) {
+				stability = 0;
+				scale *= 1.5;
+			} else {
+				stability++;
+			}
+
+			// Mate scores jump between iterations without the position getting worse
+			if (!Evaluator::isMateScore(previousEval) && eval < previousEval - scoreDropMargin) {
+				scale *= 1.3;
+			}
+		}
+
+		if (stability >= stableIterations) {
+			scale *= 0.5;
+		}
+
+		previousBestMove = bestMove;
+		previousEval = eval;
+		iterations++;
+
+		double scaledOptimum = min(double(maximumMs), optimumMs * scale);
+		return elapsed() > scaledOptimum * 0.5;
+	}
+
+}
@@ -1,6 +1,7 @@
 #include "Evaluator.h"
 #include "TranspositionTable.h"
 
+#include <algorithm>
 #include <iostream>
 
 using namespace std;
@@ -10,64 +11,67 @@ namespace SandalBot {
 	TranspositionTable::TranspositionTable(int sizeMB) {
 		this->size = (sizeMB * 1024ULL * 1024ULL) / sizeof(Entry);
 		this->table = new Entry[size];
-		this->slotsFilled = 0ULL;
-	}
-
-	TranspositionTable& TranspositionTable::operator=(const TranspositionTable& other) {
-		if (this != &other) {
-			delete[] table;  // free old memory
-			size = other.size;
-			slotsFilled = other.slotsFilled;
-			table = new Entry[size];
-			std::copy(other.table, other.table + size, table);
-		}
-		return *this;
 	}
 
 	// Get best move found from indexed hashkey
 	Move TranspositionTable::getBestMove(HashKey hashKey) {
-		if (table[getIndex(hashKey)].hash != hashKey)
-			return std::move(nullMove); // Return null move if no entry found
+		uint64_t data;
+		if (!read(hashKey, data))
+			return Move(); // Return null move if no entry found
 
-		return std::move(table[getIndex(hashKey)].move);
+		return unpackMove(data);
 	}
 
 	// Return depth of entry from given hashkey
 	int TranspositionTable::getDepth(HashKey hashKey) {
+		uint64_t data;
 		// If entry doesn't exist, return invalid depth
-		if (table[getIndex(hashKey)].hash != hashKey)
+		if (!read(hashKey, data))
 			return -1;
 
-		return table[getIndex(hashKey)].depth;
+		return unpackDepth(data);
 	}
 
 	// Store position entry
 	void TranspositionTable::store(int eval, int16_t remainingDepth, int16_t currentDepth, uint8_t nodeType, Move move, HashKey hashKey) {
-		size_t index = getIndex(hashKey);
-		if (table[index].hash == 0ULL && slotsFilled < size) {
-			slotsFilled++; // Update slots filled
-		}
-		// Move entry into table
-		table[index] = Entry(hashKey, storeMateScore(eval, currentDepth), remainingDepth, nodeType, std::move(move));
+		Entry& entry = table[getIndex(hashKey)];
+		uint64_t data = pack(storeMateScore(eval, currentDepth), remainingDepth, nodeType, move);
+
+		entry.key.store(hashKey ^ data, std::memory_order_relaxed);
+		entry.data.store(data, std::memory_order_relaxed);
 	}
 
 	// Retrieve evaluation, if entry has same hashkey, greater or equal depth, and valid node type
-	int TranspositionTable::lookup(int16_t remainingDepth, int16_t currentDepth, int alpha, int beta, HashKey hashKey) {
-		size_t index = getIndex(hashKey);
-		Entry& entry = table[index]; // Retrieve index
-
+	int TranspositionTable::lookup(int16_t remainingDepth, int16_t currentDepth, int alpha, int beta, HashKey hashKey, ProbeCounters& counters) {
+		const Entry& entry = table[getIndex(hashKey)]; // Retrieve index
+		uint64_t data = entry.data.load(std::memory_order_relaxed);
+		HashKey storedHash = entry.key.load(std::memory_order_relaxed) ^ data;
+		counters.probes++;
+
+		if (storedHash != hashKey) {
+			if (storedHash != 0ULL) {
+				counters.collisions++;
+			}
+			return notFound;
+		}
+		counters.hits++;
 
-		if (entry.hash == hashKey && (entry.depth >= remainingDepth || Evaluator::isMateScore(entry.eval))) {
+		int storedEval = unpackEval(data);
+		if (unpackDepth(data) >= remainingDepth || Evaluator::isMateScore(storedEval)) {
 			// Convert mate score to caller's depth, avoids conflicting prioritisation of different
 			// checkmates
-			int eval = retrieveMateScore(entry.eval, currentDepth); 
-			if (entry.nodeType == exact) {
+			int eval = retrieveMateScore(storedEval, currentDepth);
+			uint8_t nodeType = unpackNodeType(data);
+			if (nodeType == exact) {
+				counters.cutoffs++;
 				return eval;
 			}
-			if (entry.nodeType == upperBound && eval <= alpha) {
+			if (nodeType == upperBound && eval <= alpha) {
+				counters.cutoffs++;
 				return eval;
 			}
-			if (entry.nodeType == lowerBound && eval >= beta) {
+			if (nodeType == lowerBound && eval >= beta) {
+				counters.cutoffs++;
 				return eval;
 			}
 		}
@@ -75,13 +79,36 @@ namespace SandalBot {
 		return notFound;
 	}
 
-	// Clear table
+	// Clear table in place, searchers sharing it may still be probing it
 	void TranspositionTable::clear() {
 		if (table == nullptr)
 			return;
-		slotsFilled = 0ULL;
-		delete[] table;
-		table = new Entry[size];
+		for (std::size_t i = 0; i < size; i++) {
+			table[i].key.store(0ULL, std::memory_order_relaxed);
+			table[i].data.store(0ULL, std::memory_order_relaxed);
+		}
+	}
+
+	// Permille of slots in use, sampled from the first thousand slots so stores need not count them
+	int TranspositionTable::hashfull() const {
+		std::size_t sampled = std::min(size, std::size_t(1000));
+		std::size_t filled = 0;
+		for (std::size_t i = 0; i < sampled; i++) {
+			filled += (table[i].key.load(std::memory_order_relaxed) ^ table[i].data.load(std::memory_order_relaxed)) != 0ULL;
+		}
+		return sampled == 0 ? 0 : int(1000 * filled / sampled);
+	}
+
+	// Packs an entry's fields into its data word
+	uint64_t TranspositionTable::pack(int eval, int16_t depth, uint8_t nodeType, Move move) {
+		return uint64_t(move.moveValue) | (uint64_t(uint16_t(depth)) << depthShift)
+			| (uint64_t(nodeType & 3) << nodeTypeShift) | (uint64_t(int64_t(eval)) << evalShift);
+	}
+
+	bool TranspositionTable::read(HashKey hash, uint64_t& data) const {
+		const Entry& entry = table[getIndex(hash)];
+		data = entry.data.load(std::memory_order_relaxed);
+		return (entry.key.load(std::memory_order_relaxed) ^ data) == hash;
 	}
 
 	// Checkmate score needs to be recalibrated to currentDepth
@@ -0,0 +1,117 @@
+#include "UCIListener.h"
+
+#include "CoordHelper.h"
+#include "Evaluator.h"
+
+using namespace std;
+
+namespace SandalBot {
+
+	// Writes one info line per best line of the iteration, numbered when there are several
+	void UCIListener::onIteration(const IterationReport& report) {
+		bool multiPV = report.lines.size() > 1;
+
+		string text;
+		for (size_t i = 0; i < report.lines.size(); i++) {
+			const RootLine& line = report.lines[i];
+			text += "info depth " + to_string(report.depth) + " seldepth " + to_string(report.seldepth);
+			if (multiPV) {
+				text += " multipv " + to_string(i + 1);
+			}
+			text += " score " + score(line.eval) + " nodes " + to_string(report.nodes);
+			text += " nps " + to_string(report.nps) + " hashfull " + to_string(report.hashfull);
+			text += " time " + to_string(report.timeMs);
+
+			// If principal variation exists, write it
+			if (!line.pv.empty()) {
+				text += " pv";
+				for (Move move : line.pv) {
+					text += ' ';
+					text += uciMove(move);
+				}
+			}
+			text += '\n';
+		}
+		writer.write(text);
+	}
+
+	void UCIListener::onCurrentMove(int depth, Move move, int moveNumber, uint64_t timeMs) {
+		if (timeMs < currentMoveDelayMs) {
+			return;
+		}
+		writer.writeLine("info depth " + to_string(depth) + " currmove " + uciMove(move) + " currmovenumber " + to_string(moveNumber));
+	}
+
+	// Writes the best move, with the expected reply to ponder on when there is one
+	void UCIListener::onBestMove(Move move, Move ponder) {
+		string text = "bestmove " + uciMove(move);
+		if (ponder != Move()) {
+			text += " ponder " + uciMove(ponder);
+		}
+		writer.writeLine(text);
+	}
+
+	// Divide lines are collected, so a perft run is written at once when its total is reported
+	void UCIListener::onPerftMove(Move move, uint64_t nodes) {
+		perftLines += uciMove(move) + ": " + to_string(nodes) + '\n';
+	}
+
+	void UCIListener::writePerft(string_view text) {
+		perftLines += text;
+		writer.write(perftLines);
+		perftLines.clear();
+	}
+
+	// Writes each line of text as an info string
+	void UCIListener::onInfo(string_view text) {
+		string lines;
+		while (!text.empty()) {
+			size_t end = text.find('\n');
+			string_view line = text.substr(0, end);
+			if (!line.empty()) {
+				lines += "info string ";
+				lines += line;
+				lines += '\n';
+			}
+			text = end == string_view::npos ? string_view() : text.substr(end + 1);
+		}
+		writer.write(lines);
+	}
+
+	// Converts a move to pure algebraic coordinate notation, e.g. "e7e8q". Castling is written as
+	// the king's move
+	string UCIListener::uciMove(Move move) {
+		string flag = "";
+		switch (move.flag()) {
+		case Move::Flag::QUEEN:
+			flag = "q";
+			break;
+		case Move::Flag::BISHOP:
+			flag = "b";
+			break;
+		case Move::Flag::KNIGHT:
+			flag = "n";
+			break;
+		case Move::Flag::ROOK:
+			flag = "r";
+			break;
+		default:
+			break;
+		}
+
+		return CoordHelper::indexToString(move.from()) + CoordHelper::indexToString(move.to()) + flag;
+	}
+
+	// Formats an evaluation as centipawns, or as moves until mate
+	string UCIListener::score(int eval) {
+		int movesRemaining = Evaluator::movesTilMate(eval);
+		string sign = eval >= 0 ? "" : "-";
+		// If checkmate
+		if (movesRemaining != 0) {
+			return "mate " + sign + to_string(movesRemaining);
+		}
+
+		return "cp " + to_string(eval); // centipawn eval
+	}
+
+}
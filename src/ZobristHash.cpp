@@ -1,45 +1,70 @@
 #include "Board.h"
 #include "ZobristHash.h"
 
+#include <array>
 #include <cassert>
-#include <functional>
-#include <iostream>
-#include <random>
 
 
 using namespace std;
 
 namespace SandalBot {
 
-	HashKey ZobristHash::pieceHashes[2][7][64];
-	HashKey ZobristHash::enPassantHash[64];
-	HashKey ZobristHash::castlingRightsHash[17];
-	HashKey ZobristHash::whiteMoveHash;
+	// xorshift64* generator (https://vigna.di.unimi.it/ftp/papers/xorshift.pdf), usable in constant expressions
+	class PRNG {
+	public:
+		constexpr explicit PRNG(uint64_t seed) : state(seed) {}
 
-	// Initialises hash member values
-	void ZobristHash::initHashes() {
-		std::mt19937_64 rng(0x1234);
+		constexpr uint64_t next() {
+			state ^= state >> 12;
+			state ^= state << 25;
+			state ^= state >> 27;
+			return state * 2685821657736338717ULL;
+		}
+	private:
+		uint64_t state;
+	};
+
+	struct ZobristKeys {
+		std::array<std::array<std::array<HashKey, SQUARES_NB>, PIECE_TYPE_NB>, COLOR_NB> pieceHashes{};
+		std::array<HashKey, SQUARES_NB> enPassantHash{};
+		std::array<HashKey, RIGHTS_NB> castlingRightsHash{};
+		HashKey whiteMoveHash{};
+	};
+
+	// Generates hash values
+	static constexpr ZobristKeys initHashes() {
+		ZobristKeys keys{};
+		PRNG rng(0x1234);
 
 		// Iterate over every color, piece and square to produce unique hash values
 		for (PieceType type = PAWN; type <= KING; ++type) {
 			for (Square sq = START_SQUARE; sq < SQUARES_NB; ++sq) {
-				pieceHashes[BLACK][type][sq] = rng();
-				pieceHashes[WHITE][type][sq] = rng();
+				keys.pieceHashes[BLACK][type][sq] = rng.next();
+				keys.pieceHashes[WHITE][type][sq] = rng.next();
 			}
 		}
 
 		// Init en passant hashes
 		for (Square sq = START_SQUARE; sq < SQUARES_NB; ++sq) {
-			enPassantHash[sq] = rng();
+			keys.enPassantHash[sq] = rng.next();
 		}
 		// Init castling hashes
 		for (CastlingRights cr = NO_RIGHTS; cr < RIGHTS_NB; ++cr) {
-			castlingRightsHash[int(cr)] = rng();
+			keys.castlingRightsHash[int(cr)] = rng.next();
 		}
 
-		whiteMoveHash = rng();
+		keys.whiteMoveHash = rng.next();
+
+		return keys;
 	}
 
+	static constexpr ZobristKeys keys = initHashes();
+
+	constexpr std::array<std::array<std::array<HashKey, SQUARES_NB>, PIECE_TYPE_NB>, COLOR_NB> ZobristHash::pieceHashes = keys.pieceHashes;
+	constexpr std::array<HashKey, SQUARES_NB> ZobristHash::enPassantHash = keys.enPassantHash;
+	constexpr std::array<HashKey, RIGHTS_NB> ZobristHash::castlingRightsHash = keys.castlingRightsHash;
+	constexpr HashKey ZobristHash::whiteMoveHash = keys.whiteMoveHash;
+
 	// Static function returns hash of a given board
 	HashKey ZobristHash::hashBoard(Board* board) {
 		assert(board != nullptr);
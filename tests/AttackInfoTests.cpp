@@ -0,0 +1,141 @@
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "AttackInfo.h"
+#include "Board.h"
+#include "InitGlobals.h"
+#include "KoggeStone.h"
+#include "Types.h"
+
+using namespace SandalBot;
+
+TEST(AttackInfo, StartPosition) {
+	GlobalInit::SetUpTestSuite();
+	Board board;
+
+	const AttackInfo& info = board.attacks(true);
+
+	EXPECT_FALSE(info.isCheck());
+	EXPECT_EQ(0ULL, info.pinned);
+	// Pawns attack the whole third and sixth rows
+	EXPECT_EQ(0x0000FF0000000000ULL, info.attacks[WHITE][PAWN]);
+	EXPECT_EQ(0x0000000000FF0000ULL, info.attacks[BLACK][PAWN]);
+}
+
+TEST(AttackInfo, CheckersAndCheckMask) {
+	GlobalInit::SetUpTestSuite();
+	Board board;
+	board.loadPosition("4k3/8/8/8/8/8/8/r3K3 w - - 0 1");
+
+	const AttackInfo& info = board.attacks();
+
+	EXPECT_TRUE(info.isCheck());
+	EXPECT_FALSE(info.isDoubleCheck());
+	EXPECT_EQ(1ULL << A1, info.checkers);
+	EXPECT_EQ((1ULL << A1) | (1ULL << B1) | (1ULL << C1) | (1ULL << D1), info.checkMask);
+	// King cannot retreat along the checking rook's line
+	EXPECT_TRUE(info.opponentAttacks & (1ULL << F1));
+}
+
+TEST(AttackInfo, DoubleCheck) {
+	GlobalInit::SetUpTestSuite();
+	Board board;
+	board.loadPosition("4k3/8/8/8/1b6/8/8/4K2r w - - 0 1");
+
+	EXPECT_TRUE(board.attacks().isDoubleCheck());
+}
+
+TEST(AttackInfo, Pins) {
+	GlobalInit::SetUpTestSuite();
+	Board board;
+	board.loadPosition("4k3/4r3/8/8/1b6/8/3NN3/4K3 w - - 0 1");
+
+	const AttackInfo& info = board.attacks();
+
+	EXPECT_FALSE(info.isCheck());
+	EXPECT_EQ((1ULL << D2) | (1ULL << E2), info.pinned);
+}
+
+TEST(AttackInfo, RecomputedAfterMove) {
+	GlobalInit::SetUpTestSuite();
+	Board board;
+	board.loadPosition("4k3/8/8/8/8/8/8/R3K3 w - - 0 1");
+
+	EXPECT_FALSE(board.attacks().isCheck());
+
+	board.makeMove(Move(A1, A8, Move::Flag::NO_FLAG));
+	EXPECT_TRUE(board.attacks().isCheck());
+
+	board.unMakeMove();
+	EXPECT_FALSE(board.attacks().isCheck());
+}
+
+TEST(AttackInfo, KoggeStoneMatchesMagics) {
+	GlobalInit::SetUpTestSuite();
+	uint64_t seed = 0x9E3779B97F4A7C15ULL;
+	auto random = [&seed]() {
+		seed ^= seed >> 12;
+		seed ^= seed << 25;
+		seed ^= seed >> 27;
+		return seed * 0x2545F4914F6CDD1DULL;
+	};
+
+	for (int i = 0; i < 10000; i++) {
+		Bitboard occupied = random() & random();
+		Bitboard sliders = occupied & random() & random();
+		Bitboard empty = ~occupied;
+
+		Bitboard orthogonal = 0ULL;
+		Bitboard diagonal = 0ULL;
+		Bitboard temp = sliders;
+		while (temp != 0ULL) {
+			Square sq = popLSB(temp);
+			orthogonal |= getMovementBoard<ROOK>(sq, occupied);
+			diagonal |= getMovementBoard<BISHOP>(sq, occupied);
+		}
+
+		ASSERT_EQ(orthogonal, KoggeStone::orthogonalAttacks(sliders, empty));
+		ASSERT_EQ(diagonal, KoggeStone::diagonalAttacks(sliders, empty));
+		ASSERT_EQ(orthogonal, KoggeStone::orthogonalUnion(sliders, empty));
+		ASSERT_EQ(diagonal, KoggeStone::diagonalUnion(sliders, empty));
+	}
+}
+
+TEST(AttackInfo, PextMatchesMagics) {
+	GlobalInit::SetUpTestSuite();
+	if (!BitMagics::pextSupported()) {
+		GTEST_SKIP() << "PEXT not supported";
+	}
+
+	uint64_t seed = 0x2545F4914F6CDD1DULL;
+	auto random = [&seed]() {
+		seed ^= seed >> 12;
+		seed ^= seed << 25;
+		seed ^= seed >> 27;
+		return seed * 0x9E3779B97F4A7C15ULL;
+	};
+
+	std::vector<Bitboard> occupancies;
+	for (int i = 0; i < 1000; i++) {
+		occupancies.push_back(random() & random());
+	}
+
+	auto lookups = [&occupancies]() {
+		std::vector<Bitboard> result;
+		for (Bitboard occupied : occupancies) {
+			for (Square sq = START_SQUARE; sq < SQUARES_NB; ++sq) {
+				result.push_back(getMovementBoard<ROOK>(sq, occupied));
+				result.push_back(getMovementBoard<BISHOP>(sq, occupied));
+			}
+		}
+		return result;
+	};
+
+	setSlidingBackend(BitMagics::Backend::MAGIC);
+	std::vector<Bitboard> magicMoves = lookups();
+	setSlidingBackend(BitMagics::Backend::PEXT);
+	std::vector<Bitboard> pextMoves = lookups();
+
+	EXPECT_EQ(magicMoves, pextMoves);
+}
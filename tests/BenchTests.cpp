@@ -0,0 +1,33 @@
+#include <sstream>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "Bench.h"
+#include "InitGlobals.h"
+
+using namespace SandalBot;
+
+TEST(Bench, SignatureIndependentOfThreads) {
+    GlobalInit::SetUpTestSuite();
+
+    std::stringstream singleOut;
+    std::stringstream threadedOut;
+    Bench::Result single = Bench::run(3, 1, 1, singleOut);
+    Bench::Result threaded = Bench::run(3, 3, 1, threadedOut);
+
+    // Positions are reported in suite order with the same counts
+    EXPECT_NE(0ULL, single.nodes);
+    EXPECT_EQ(single.nodes, threaded.nodes);
+    EXPECT_EQ(singleOut.str().substr(0, singleOut.str().find("\n\n")),
+        threadedOut.str().substr(0, threadedOut.str().find("\n\n")));
+    EXPECT_NE(std::string::npos, singleOut.str().find("Nodes searched  : " + std::to_string(single.nodes)));
+}
+
+TEST(Bench, HashSizeIsClamped) {
+    GlobalInit::SetUpTestSuite();
+
+    // A table of no entries would have no slot to index
+    std::stringstream out;
+    EXPECT_NE(0ULL, Bench::run(1, 1, 0, out).nodes);
+}
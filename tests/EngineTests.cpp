@@ -0,0 +1,172 @@
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Engine.h"
+#include "SandalBotC.h"
+
+using namespace SandalBot;
+
+namespace {
+
+    const std::vector<std::string> positions{
+        "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+        "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+        "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+        "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",
+    };
+
+}
+
+TEST(Engine, InstancesShareTableAndSearchAsync) {
+    std::shared_ptr<TranspositionTable> table = Engine::createTable(4);
+    EngineOptions options;
+    options.sharedTable = table;
+
+    // Many engines search at once, each reporting to its own callback
+    constexpr int engineCount = 16;
+    std::vector<std::unique_ptr<Engine>> engines;
+    std::vector<SearchResult> results(engineCount);
+    std::atomic<int> completed{ 0 };
+    for (int i = 0; i < engineCount; i++) {
+        engines.push_back(std::make_unique<Engine>(options));
+        engines[i]->setPosition(positions[i % positions.size()]);
+
+        SearchRequest request;
+        request.depth = 4;
+        engines[i]->searchAsync(request, [&, i](const SearchResult& result) {
+            results[i] = result;
+            completed++;
+        });
+    }
+    for (std::unique_ptr<Engine>& engine : engines) {
+        engine->wait();
+    }
+
+    EXPECT_EQ(engineCount, completed.load());
+    for (const SearchResult& result : results) {
+        EXPECT_NE(0, result.bestMove.moveValue);
+        EXPECT_EQ(4, result.depth);
+        ASSERT_EQ(1U, result.lines.size());
+        EXPECT_EQ(result.bestMove.moveValue, result.lines[0].move.moveValue);
+    }
+}
+
+TEST(Engine, SharedTableClearedWhileSearching) {
+    std::shared_ptr<TranspositionTable> table = Engine::createTable(1);
+    EngineOptions options;
+    options.sharedTable = table;
+
+    std::vector<std::unique_ptr<Engine>> engines;
+    for (size_t i = 0; i < positions.size(); i++) {
+        engines.push_back(std::make_unique<Engine>(options));
+        engines[i]->setPosition(positions[i]);
+        engines[i]->searchAsync(SearchRequest(), nullptr);
+    }
+
+    // The table is cleared in place, so searches probing it meanwhile keep a valid table
+    for (int i = 0; i < 20; i++) {
+        table->clear();
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    for (std::unique_ptr<Engine>& engine : engines) {
+        engine->stop();
+        engine->wait();
+    }
+    table->clear();
+    EXPECT_EQ(0, table->hashfull());
+}
+
+TEST(Engine, StopEndsUnlimitedSearch) {
+    EngineOptions options;
+    options.hashSizeMB = 1;
+    Engine engine(options);
+    EXPECT_TRUE(engine.setPosition(positions[1], { "e2a6", "b4c3" }));
+    EXPECT_FALSE(engine.makeMove("e1e3"));
+
+    std::atomic<bool> finished{ false };
+    SearchResult result;
+    engine.searchAsync(SearchRequest(), [&](const SearchResult& searchResult) {
+        result = searchResult;
+        finished = true;
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    EXPECT_FALSE(finished.load());
+
+    engine.stop();
+    engine.wait();
+    EXPECT_TRUE(finished.load());
+    EXPECT_NE(0, result.bestMove.moveValue);
+
+    // Stopping at once is not lost, even before the search has started
+    engine.searchAsync(SearchRequest(), nullptr);
+    engine.stop();
+    engine.wait();
+    EXPECT_FALSE(engine.searching());
+
+    // Nor in positions without a legal move, where the search never reaches a root move
+    for (const char* fen : { "7k/5Q2/6K1/8/8/8/8/8 b - - 0 1", "7k/6Q1/6K1/8/8/8/8/8 b - - 0 1" }) {
+        EXPECT_TRUE(engine.setPosition(fen));
+        engine.searchAsync(SearchRequest(), [&](const SearchResult& searchResult) {
+            result = searchResult;
+        });
+        engine.stop();
+        engine.wait();
+        EXPECT_EQ(0, result.bestMove.moveValue) << fen;
+    }
+}
+
+TEST(Engine, CInterface) {
+    sandalbot_table* table = sandalbot_table_create(1);
+    ASSERT_NE(nullptr, table);
+    sandalbot_engine* first = sandalbot_engine_create(0, table);
+    sandalbot_engine* second = sandalbot_engine_create(0, table);
+    sandalbot_table_release(table);
+    ASSERT_NE(nullptr, first);
+    ASSERT_NE(nullptr, second);
+
+    // Back rank mate in one
+    EXPECT_EQ(SANDALBOT_OK, sandalbot_engine_set_position(first, "6k1/5ppp/8/8/8/8/5PPP/R5K1 w - - 0 1", nullptr));
+    sandalbot_limits limits{};
+    limits.depth = 3;
+    sandalbot_result result{};
+    EXPECT_EQ(SANDALBOT_OK, sandalbot_engine_search(first, &limits, &result));
+    EXPECT_STREQ("a1a8", result.best_move);
+    EXPECT_EQ(1, result.mate);
+
+    struct Completion {
+        std::atomic<bool> called{ false };
+        sandalbot_result result{};
+    } completion;
+    EXPECT_EQ(SANDALBOT_OK, sandalbot_engine_set_position(second, "startpos", "e2e4 e7e5"));
+    EXPECT_EQ(SANDALBOT_ERROR, sandalbot_engine_set_position(second, "8/8/8", nullptr));
+    EXPECT_EQ(SANDALBOT_ERROR, sandalbot_engine_make_move(second, "e1e8"));
+    EXPECT_EQ(SANDALBOT_OK, sandalbot_engine_search_async(second, &limits, [](const sandalbot_result* result, void* data) {
+        Completion* completion = static_cast<Completion*>(data);
+        completion->result = *result;
+        completion->called = true;
+    }, &completion));
+    sandalbot_engine_wait(second);
+
+    EXPECT_TRUE(completion.called.load());
+    EXPECT_EQ(3, completion.result.depth);
+    EXPECT_NE('\0', completion.result.best_move[0]);
+
+    sandalbot_engine_destroy(first);
+    sandalbot_engine_destroy(second);
+
+    // Null engines are errors rather than crashes
+    EXPECT_EQ(SANDALBOT_ERROR, sandalbot_engine_new_game(nullptr));
+    EXPECT_EQ(SANDALBOT_ERROR, sandalbot_engine_set_position(nullptr, nullptr, nullptr));
+    EXPECT_EQ(SANDALBOT_ERROR, sandalbot_engine_make_move(nullptr, "e2e4"));
+    EXPECT_EQ(SANDALBOT_ERROR, sandalbot_engine_search(nullptr, &limits, &result));
+    EXPECT_EQ(SANDALBOT_ERROR, sandalbot_engine_search_async(nullptr, &limits, nullptr, nullptr));
+    EXPECT_EQ(SANDALBOT_ERROR, sandalbot_engine_stop(nullptr));
+    EXPECT_EQ(SANDALBOT_ERROR, sandalbot_engine_wait(nullptr));
+    sandalbot_engine_destroy(nullptr);
+}
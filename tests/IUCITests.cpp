@@ -0,0 +1,165 @@
+#include <chrono>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include "IUCI.h"
+#include "InitGlobals.h"
+#include "UCIListener.h"
+
+using namespace SandalBot;
+
+namespace {
+
+    // Milliseconds from sending stop during a search until bestmove has been written
+    double stopLatencyMs(IUCI& engine, const std::string& goCommand) {
+        engine.processCommand("position startpos");
+        engine.processCommand(goCommand);
+        std::this_thread::sleep_for(std::chrono::milliseconds(200));
+
+        auto start = std::chrono::steady_clock::now();
+        engine.processCommand("stop");
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+
+}
+
+TEST(IUCI, StopToBestMoveLatency) {
+    GlobalInit::SetUpTestSuite();
+    IUCI engine;
+
+    testing::internal::CaptureStdout();
+    double infiniteMs = stopLatencyMs(engine, "go infinite");
+    double clockMs = stopLatencyMs(engine, "go wtime 60000 btime 60000");
+    std::string output = testing::internal::GetCapturedStdout();
+
+    RecordProperty("InfiniteStopLatencyUs", int(infiniteMs * 1000.0));
+    RecordProperty("ClockStopLatencyUs", int(clockMs * 1000.0));
+    EXPECT_LT(infiniteMs, 20.0);
+    EXPECT_LT(clockMs, 20.0);
+
+    // Both searches reported a move
+    size_t first = output.find("bestmove");
+    ASSERT_NE(std::string::npos, first);
+    EXPECT_NE(std::string::npos, output.find("bestmove", first + 1));
+}
+
+TEST(IUCI, StopStraightAfterGoIsNotLost) {
+    GlobalInit::SetUpTestSuite();
+    IUCI engine;
+    engine.processCommand("position startpos");
+
+    // Stop often arrives before the search thread has started the search, which must still end
+    constexpr int searches = 50;
+    testing::internal::CaptureStdout();
+    for (int i = 0; i < searches; ++i) {
+        engine.processCommand(i % 2 == 0 ? "go infinite" : "go ponder wtime 60000 btime 60000");
+        engine.processCommand("stop");
+    }
+    std::string output = testing::internal::GetCapturedStdout();
+
+    int bestMoves = 0;
+    for (size_t at = output.find("bestmove"); at != std::string::npos; at = output.find("bestmove", at + 1)) {
+        bestMoves++;
+    }
+    EXPECT_EQ(searches, bestMoves);
+}
+
+TEST(IUCI, LoopAnswersIsReadyDuringSearch) {
+    GlobalInit::SetUpTestSuite();
+    IUCI engine;
+    std::istringstream input("position startpos\ngo movetime 300\nisready\nquit\n");
+
+    testing::internal::CaptureStdout();
+    engine.loop(input);
+    std::string output = testing::internal::GetCapturedStdout();
+
+    // isready is answered before the search ends, and quit waits for the move
+    size_t ready = output.find("readyok");
+    ASSERT_NE(std::string::npos, ready);
+    EXPECT_NE(std::string::npos, output.find("bestmove", ready));
+}
+
+TEST(IUCI, LoopAnswersIsReadyDuringBenchAndPerft) {
+    GlobalInit::SetUpTestSuite();
+    IUCI engine;
+    std::istringstream input("bench 5\nisready\nposition startpos\ngo perft 6\nisready\nquit\n");
+
+    testing::internal::CaptureStdout();
+    engine.loop(input);
+    std::string output = testing::internal::GetCapturedStdout();
+
+    // Each isready is answered before the report of the command running ahead of it
+    size_t firstReady = output.find("readyok");
+    size_t benchReport = output.find("Nodes searched  :");
+    ASSERT_NE(std::string::npos, firstReady);
+    ASSERT_NE(std::string::npos, benchReport);
+    EXPECT_LT(firstReady, benchReport);
+
+    size_t secondReady = output.find("readyok", benchReport);
+    size_t perftReport = output.find("Nodes searched: 119060324");
+    ASSERT_NE(std::string::npos, secondReady);
+    ASSERT_NE(std::string::npos, perftReport);
+    EXPECT_LT(secondReady, perftReport);
+}
+
+TEST(IUCI, PerftDivideIsWrittenWithItsTotal) {
+    std::ostringstream out;
+    BufferedWriter writer(out);
+    UCIListener listener(writer);
+
+    // A response written while perft runs cannot land between its divide lines
+    listener.onPerftMove(Move(E2, E4), 20);
+    writer.writeLine("readyok");
+    listener.onPerftMove(Move(D2, D4), 20);
+    listener.writePerft("Nodes searched: 40\n");
+
+    EXPECT_EQ("readyok\ne2e4: 20\nd2d4: 20\nNodes searched: 40\n", out.str());
+}
+
+TEST(IUCI, LoopEndsAtEndOfInput) {
+    GlobalInit::SetUpTestSuite();
+    IUCI engine;
+    std::istringstream input("position startpos\n");
+
+    engine.loop(input);
+    SUCCEED();
+}
+
+TEST(IUCI, PositionMovesExtendCurrentGame) {
+    GlobalInit::SetUpTestSuite();
+    IUCI incremental;
+    IUCI reloaded;
+    const std::string game = "position startpos moves e2e4 g8f6 e4e5 d7d5 e5d6 e7d6 g1f3 f8e7 f1c4";
+    const std::string special = " e8g8 e1g1 b8c6 b1c3 c8e6";
+    auto board = [](IUCI& engine) {
+        testing::internal::CaptureStdout();
+        engine.processCommand("d");
+        return testing::internal::GetCapturedStdout();
+    };
+
+    // En passant, castling and a skipped illegal move played one command at a time match a single command
+    incremental.processCommand(game);
+    incremental.processCommand(game + special);
+    incremental.processCommand(game + special + " a2a5 a2a4");
+    reloaded.processCommand(game + special + " a2a5 a2a4");
+    EXPECT_EQ(board(reloaded), board(incremental));
+
+    // Taking back a move reloads the position
+    incremental.processCommand(game + special);
+    reloaded.processCommand(game + special);
+    EXPECT_EQ(board(reloaded), board(incremental));
+
+    // Promotions need their piece
+    incremental.processCommand("position fen 8/P6k/8/8/8/8/8/K7 w - - 0 1 moves a7a8q h7g6");
+    EXPECT_NE(std::string::npos, board(incremental).find("Q7/8/6k1"));
+
+    // Squares off the board are not wrapped onto a neighbouring rank, which would make h2h4 and h2h3
+    reloaded.processCommand("position startpos");
+    for (const std::string move : { "i1h4", "h2i2" }) {
+        incremental.processCommand("position startpos moves " + move);
+        EXPECT_EQ(board(reloaded), board(incremental)) << move;
+    }
+}
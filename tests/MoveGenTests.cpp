@@ -0,0 +1,192 @@
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Board.h"
+#include "InitGlobals.h"
+#include "MoveGen.h"
+#include "MoveOrderer.h"
+#include "Types.h"
+
+using namespace SandalBot;
+
+namespace {
+
+	template <GenType Gen>
+	std::vector<uint16_t> generateSorted(MoveGen& generator) {
+		MovePoint moves[MoveGen::maxMoves];
+		int numMoves = generator.generate<Gen>(moves);
+
+		std::vector<uint16_t> result;
+		for (int i = 0; i < numMoves; i++) {
+			result.push_back(moves[i].move.moveValue);
+		}
+		std::sort(result.begin(), result.end());
+		return result;
+	}
+
+	bool givesCheck(Board& board, Move move) {
+		board.makeMove(move);
+		bool check = board.attacks().isCheck();
+		board.unMakeMove();
+		return check;
+	}
+
+	// Pseudo legal moves which Board::isLegal accepts
+	std::vector<uint16_t> generateLegalFromPseudo(Board& board, MoveGen& generator) {
+		MovePoint moves[MoveGen::maxMoves];
+		int numMoves = generator.generate<PSEUDO_LEGAL>(moves);
+
+		std::vector<uint16_t> result;
+		for (int i = 0; i < numMoves; i++) {
+			if (board.isLegal(moves[i].move)) {
+				result.push_back(moves[i].move.moveValue);
+			}
+		}
+		std::sort(result.begin(), result.end());
+		return result;
+	}
+
+	// Verifies every slice against the full legal move list, recursing over all legal moves
+	void checkSlices(Board& board, MoveGen& generator, int depth) {
+		std::vector<uint16_t> legal = generateSorted<LEGAL>(generator);
+		std::vector<uint16_t> captures = generateSorted<CAPTURES>(generator);
+		std::vector<uint16_t> quiets = generateSorted<QUIETS>(generator);
+
+		std::vector<uint16_t> combined;
+		std::merge(captures.begin(), captures.end(), quiets.begin(), quiets.end(), std::back_inserter(combined));
+		ASSERT_EQ(legal, combined);
+		ASSERT_EQ(legal, generateLegalFromPseudo(board, generator));
+
+		if (board.attacks().isCheck()) {
+			ASSERT_EQ(legal, generateSorted<EVASIONS>(generator));
+		} else {
+			std::vector<uint16_t> expectedChecks;
+			for (uint16_t value : quiets) {
+				Move move(value);
+				if (move.flag() == Move::Flag::CASTLE || move.isPromotion()) {
+					continue;
+				}
+				if (givesCheck(board, move)) {
+					expectedChecks.push_back(value);
+				}
+			}
+			ASSERT_EQ(expectedChecks, generateSorted<QUIET_CHECKS>(generator));
+		}
+
+		if (depth == 1) {
+			return;
+		}
+
+		for (uint16_t value : legal) {
+			board.makeMove(Move(value));
+			checkSlices(board, generator, depth - 1);
+			board.unMakeMove();
+		}
+	}
+
+}
+
+class MoveGenSlices : public ::testing::TestWithParam<std::string> {};
+
+TEST_P(MoveGenSlices, SlicesPartitionLegalMoves) {
+	GlobalInit::SetUpTestSuite();
+	Board board;
+	board.loadPosition(GetParam());
+	MoveGen generator(&board);
+
+	checkSlices(board, generator, 2);
+}
+
+INSTANTIATE_TEST_SUITE_P(
+	MoveGen,
+	MoveGenSlices,
+	::testing::Values(
+		"rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+		"r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+		"8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+		"r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",
+		"rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8",
+		"4k3/8/8/8/1b6/8/8/4K2r w - - 0 1",
+		"4k3/8/4r3/8/8/4B3/4P3/4K3 b - - 0 1"
+	)
+);
+
+TEST_P(MoveGenSlices, PseudoLegalValidatesAnyMove) {
+	GlobalInit::SetUpTestSuite();
+	Board board;
+	board.loadPosition(GetParam());
+	MoveGen generator(&board);
+
+	// Every encodable move is accepted exactly when it is legal
+	std::vector<uint16_t> accepted;
+	for (uint32_t value = 0; value <= UINT16_MAX; value++) {
+		Move move(static_cast<uint16_t>(value));
+		if (board.isPseudoLegal(move) && board.isLegal(move)) {
+			accepted.push_back(move.moveValue);
+		}
+	}
+
+	EXPECT_EQ(generateSorted<LEGAL>(generator), accepted);
+}
+
+TEST_P(MoveGenSlices, GivesCheckMatchesMadeMove) {
+	GlobalInit::SetUpTestSuite();
+	Board board;
+	board.loadPosition(GetParam());
+	MoveGen generator(&board);
+
+	// Compares every legal move of the position and its children against making the move
+	std::vector<uint16_t> rootMoves = generateSorted<LEGAL>(generator);
+	for (uint16_t rootValue : rootMoves) {
+		board.makeMove(Move(rootValue));
+		for (uint16_t value : generateSorted<LEGAL>(generator)) {
+			Move move(value);
+			ASSERT_EQ(givesCheck(board, move), board.givesCheck(move)) << move.str();
+		}
+		board.unMakeMove();
+
+		Move move(rootValue);
+		ASSERT_EQ(givesCheck(board, move), board.givesCheck(move)) << move.str();
+	}
+}
+
+TEST(MoveGen, EvasionsBlockOrCaptureChecker) {
+	GlobalInit::SetUpTestSuite();
+	Board board;
+	board.loadPosition("4k3/8/8/8/8/8/3N4/r3K3 w - - 0 1");
+	MoveGen generator(&board);
+
+	std::vector<uint16_t> evasions = generateSorted<EVASIONS>(generator);
+
+	// King steps off the first row, or the knight blocks on b1
+	std::vector<uint16_t> expected{
+		Move(E1, E2, Move::Flag::NO_FLAG).moveValue,
+		Move(E1, F2, Move::Flag::NO_FLAG).moveValue,
+		Move(D2, B1, Move::Flag::NO_FLAG).moveValue,
+	};
+	std::sort(expected.begin(), expected.end());
+
+	EXPECT_EQ(expected, evasions);
+}
+
+TEST(MoveGen, GivesCheckSpecialMoves) {
+	GlobalInit::SetUpTestSuite();
+	Board board;
+
+	// Castling rook checks along the file
+	board.loadPosition("5k2/8/8/8/8/8/8/4K2R w K - 0 1");
+	EXPECT_TRUE(board.givesCheck(Move(E1, G1, Move::Flag::CASTLE)));
+
+	// En passant removes both pawns between the rook and king
+	board.loadPosition("8/8/8/k2pP2R/8/8/8/4K3 w - d6 0 1");
+	EXPECT_TRUE(board.givesCheck(Move(E5, D6, Move::Flag::EN_PASSANT)));
+
+	// Under promotions check as their new piece only
+	board.loadPosition("3k4/1P6/8/8/8/8/8/4K3 w - - 0 1");
+	EXPECT_FALSE(board.givesCheck(Move(B7, B8, Move::Flag::BISHOP)));
+	EXPECT_TRUE(board.givesCheck(Move(B7, B8, Move::Flag::ROOK)));
+	EXPECT_TRUE(board.givesCheck(Move(B7, B8, Move::Flag::QUEEN)));
+}
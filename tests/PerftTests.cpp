@@ -8,6 +8,8 @@
 #include "TestFileReader.h"
 #include "Bot.h"
 #include "InitGlobals.h"
+#include "Perft.h"
+#include "UCIListener.h"
 
 using namespace SandalBot;
 
@@ -81,4 +83,71 @@ INSTANTIATE_TEST_SUITE_P(PerftTests, PerftTest, ::testing::Values(
     "PerftPosition5.txt",
     "PerftPosition6.txt",
     "PerftPosition7.txt"
-));
\ No newline at end of file
+));
+
+TEST(Perft, HashedCountsMatchUnhashed) {
+    GlobalInit::SetUpTestSuite();
+    Board board;
+    board.loadPosition("r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1");
+
+    Perft unhashed(&board);
+    unhashed.setHashSize(0);
+    Perft hashed(&board);
+    hashed.setHashSize(1);
+
+    // The second hashed run is answered from the table filled by the first
+    EXPECT_EQ(4085603ULL, unhashed.run(4));
+    EXPECT_EQ(4085603ULL, hashed.run(4));
+    EXPECT_EQ(4085603ULL, hashed.run(4));
+
+    hashed.setPseudoLegal(true);
+    hashed.setHashSize(1);
+    EXPECT_EQ(4085603ULL, hashed.run(4));
+}
+
+TEST(Perft, DivideListsRootMovesInUciNotation) {
+    GlobalInit::SetUpTestSuite();
+    Board board;
+    board.loadPosition("8/P7/8/8/8/8/8/k6K w - - 0 1");
+    Perft perft(&board);
+
+    std::stringstream out;
+    BufferedWriter writer(out);
+    UCIListener listener(writer);
+    EXPECT_EQ(7ULL, perft.divide(1, listener));
+    listener.writePerft("Nodes searched: 7\n");
+
+    std::string output = out.str();
+    EXPECT_NE(std::string::npos, output.find("a7a8q: 1\n"));
+    EXPECT_NE(std::string::npos, output.find("a7a8n: 1\n"));
+    EXPECT_NE(std::string::npos, output.find("h1g2: 1\n"));
+}
+
+TEST(Perft, ThreadedDivideMatchesSingleThreaded) {
+    GlobalInit::SetUpTestSuite();
+    Board board;
+    board.loadPosition("r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1");
+    HashKey hash = board.state->zobristHash;
+
+    Perft single(&board);
+    single.setThreads(1);
+    single.setHashSize(0);
+    Perft threaded(&board);
+    threaded.setThreads(4);
+
+    std::stringstream singleOut;
+    std::stringstream threadedOut;
+    BufferedWriter singleWriter(singleOut);
+    BufferedWriter threadedWriter(threadedOut);
+    UCIListener singleListener(singleWriter);
+    UCIListener threadedListener(threadedWriter);
+    EXPECT_EQ(422333ULL, single.divide(4, singleListener));
+    EXPECT_EQ(422333ULL, threaded.divide(4, threadedListener));
+    EXPECT_EQ(422333ULL, threaded.run(4));
+    singleWriter.flush();
+    threadedWriter.flush();
+
+    // Root moves are listed in the same order, and the board is left as it was
+    EXPECT_EQ(singleOut.str(), threadedOut.str());
+    EXPECT_EQ(hash, board.state->zobristHash);
+}
@@ -0,0 +1,44 @@
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include "SearchThread.h"
+
+using namespace SandalBot;
+
+TEST(SearchThread, RunsJobsOnOneParkedThread) {
+    SearchThread searchThread;
+    std::thread::id firstId{};
+    std::thread::id secondId{};
+
+    searchThread.start([&] { firstId = std::this_thread::get_id(); });
+    searchThread.wait();
+    searchThread.start([&] { secondId = std::this_thread::get_id(); });
+    searchThread.wait();
+
+    // Both jobs ran on the same thread, which is not the caller
+    EXPECT_FALSE(searchThread.searching());
+    EXPECT_EQ(firstId, secondId);
+    EXPECT_NE(std::this_thread::get_id(), firstId);
+}
+
+TEST(SearchThread, StartWaitsForRunningJob) {
+    SearchThread searchThread;
+    std::atomic<bool> release{ false };
+    std::atomic<int> finished{ 0 };
+
+    searchThread.start([&] {
+        while (!release) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        finished++;
+    });
+    EXPECT_TRUE(searchThread.searching());
+
+    release = true;
+    searchThread.start([&] { finished++; });
+    searchThread.wait();
+    EXPECT_EQ(2, finished.load());
+}
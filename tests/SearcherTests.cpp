@@ -0,0 +1,201 @@
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include "Board.h"
+#include "InitGlobals.h"
+#include "Searcher.h"
+
+using namespace SandalBot;
+
+namespace {
+
+    const std::string middlegame = "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1";
+
+}
+
+TEST(Searcher, MoveTimeDeadlineLatency) {
+    GlobalInit::SetUpTestSuite();
+    Board board;
+    board.loadPosition(middlegame);
+    Searcher searcher(&board);
+    searcher.setReportIterations(false);
+    searcher.setMoveOverhead(0);
+
+    // Search returns within a few polling intervals of the deadline, not a timer sleep period
+    constexpr int moveTimeMs = 250;
+    auto start = std::chrono::steady_clock::now();
+    searcher.startSearch(true, moveTimeMs);
+    auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    RecordProperty("DeadlineLatencyUs", int((elapsed - moveTimeMs) * 1000.0));
+    EXPECT_GE(elapsed, moveTimeMs);
+    EXPECT_LT(elapsed - moveTimeMs, 20.0);
+    EXPECT_NE(0, searcher.bestMove.moveValue);
+}
+
+TEST(Searcher, NodeLimitIsExact) {
+    GlobalInit::SetUpTestSuite();
+    Board board;
+    board.loadPosition(middlegame);
+    Searcher searcher(&board);
+    searcher.setReportIterations(false);
+
+    // Not a multiple of the polling interval
+    constexpr uint64_t nodeLimit = 50000;
+    searcher.setNodeLimit(nodeLimit);
+    searcher.startSearch(true, 60000);
+
+    EXPECT_EQ(nodeLimit, searcher.nodes());
+    EXPECT_NE(0, searcher.bestMove.moveValue);
+}
+
+TEST(Searcher, PonderHitContinuesWithClockTime) {
+    GlobalInit::SetUpTestSuite();
+    Board board;
+    board.loadPosition(middlegame);
+    Searcher searcher(&board);
+    searcher.setReportIterations(false);
+    searcher.setMoveOverhead(0);
+
+    // A 2 s clock allots at most 250 ms, counted from ponderhit rather than from go
+    auto start = std::chrono::steady_clock::now();
+    std::thread ponderThread([&] { searcher.startPonderSearch(2000, 0, 0, 0); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(300));
+    auto hit = std::chrono::steady_clock::now();
+    searcher.ponderHit();
+    ponderThread.join();
+    auto end = std::chrono::steady_clock::now();
+
+    EXPECT_GE(end - start, std::chrono::milliseconds(300));
+    EXPECT_LT(end - hit, std::chrono::milliseconds(250 + 20));
+    EXPECT_NE(0, searcher.bestMove.moveValue);
+}
+
+TEST(Searcher, CompletedPonderSearchWaitsForPonderHit) {
+    GlobalInit::SetUpTestSuite();
+    Board board;
+    board.loadPosition("6k1/5ppp/8/8/8/8/5PPP/R5K1 w - - 0 1");
+    Searcher searcher(&board);
+    searcher.setReportIterations(false);
+
+    // Mate is found at once, but the move is only reported after ponderhit
+    std::atomic<bool> finished{ false };
+    std::thread ponderThread([&] {
+        searcher.startPonderSearch(60000, 0, 0, 0);
+        finished = true;
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    EXPECT_FALSE(finished.load());
+
+    searcher.ponderHit();
+    ponderThread.join();
+    EXPECT_EQ(Move(A1, A8, Move::Flag::NO_FLAG).moveValue, searcher.bestMove.moveValue);
+}
+
+TEST(Searcher, LimitsEndUntimedSearch) {
+    GlobalInit::SetUpTestSuite();
+    Board board;
+    board.loadPosition(middlegame);
+    Searcher searcher(&board);
+    searcher.setReportIterations(false);
+
+    // A depth limit ends a search which would otherwise wait to be stopped
+    Searcher::SearchLimits limits;
+    limits.depth = 3;
+    searcher.setLimits(limits);
+    searcher.startSearch(false);
+    EXPECT_NE(0, searcher.bestMove.moveValue);
+
+    // Only the given root moves are searched, however poor
+    limits.searchMoves = { Move(A2, A3, Move::Flag::NO_FLAG), Move(G2, H3, Move::Flag::NO_FLAG) };
+    searcher.setLimits(limits);
+    searcher.startSearch(false);
+    EXPECT_TRUE(searcher.bestMove == limits.searchMoves[0] || searcher.bestMove == limits.searchMoves[1]);
+}
+
+TEST(Searcher, MateLimitEndsSearchAtMate) {
+    GlobalInit::SetUpTestSuite();
+    Board board;
+    board.loadPosition("r2qkb1r/pp2nppp/3p4/2pNN1B1/2BnP3/3P4/PPP2PPP/R2bK2R w KQkq - 1 1");
+    Searcher searcher(&board);
+    searcher.setReportIterations(false);
+
+    Searcher::SearchLimits limits;
+    limits.mate = 2;
+    searcher.setLimits(limits);
+    searcher.startSearch(false);
+    EXPECT_EQ(Move(D5, F6, Move::Flag::NO_FLAG).moveValue, searcher.bestMove.moveValue);
+}
+
+TEST(Searcher, MultiPVLinesAreDistinctAndOrdered) {
+    GlobalInit::SetUpTestSuite();
+    Board board;
+    Searcher searcher(&board);
+
+    constexpr int lines = 4;
+    searcher.setMultiPV(lines);
+    struct Recorder : SearchListener {
+        std::vector<IterationReport> iterations;
+        void onIteration(const IterationReport& report) override { iterations.push_back(report); }
+    } recorder;
+    searcher.setListener(&recorder);
+
+    // Every iteration's first line is the best move, and later lines, which may score higher when
+    // searched, are ordered by score. After 1. e4 later lines outscore earlier ones at some depths
+    for (const std::string& fen : { middlegame, std::string("rnbqkbnr/pppppppp/8/8/4P3/8/PPPP1PPP/RNBQKBNR b KQkq e3 0 1") }) {
+        board.loadPosition(fen);
+        searcher.clearHash();
+        recorder.iterations.clear();
+        searcher.searchToDepth(6);
+
+        ASSERT_EQ(6U, recorder.iterations.size());
+        EXPECT_EQ(searcher.bestMove.moveValue, recorder.iterations.back().lines[0].move.moveValue);
+        for (const IterationReport& report : recorder.iterations) {
+            const std::vector<RootLine>& rootLines = report.lines;
+            ASSERT_EQ(size_t(lines), rootLines.size());
+            for (size_t i = 1; i < rootLines.size(); i++) {
+                EXPECT_LE(rootLines[i].eval, rootLines[i - 1].eval) << fen << " depth " << report.depth;
+                EXPECT_FALSE(rootLines[i].pv.empty());
+                for (size_t j = 0; j < i; j++) {
+                    EXPECT_NE(rootLines[j].move.moveValue, rootLines[i].move.moveValue);
+                }
+            }
+        }
+    }
+
+    // Lines are limited by the number of legal moves
+    board.loadPosition("7k/8/8/8/8/8/8/K7 w - - 0 1");
+    searcher.searchToDepth(3);
+    EXPECT_EQ(3U, searcher.rootLines().size());
+}
+
+TEST(Searcher, ListenerReceivesIterations) {
+    GlobalInit::SetUpTestSuite();
+    Board board;
+    board.loadPosition(middlegame);
+    Searcher searcher(&board);
+
+    // Records results instead of parsing UCI output
+    struct Recorder : SearchListener {
+        std::vector<IterationReport> iterations;
+        int currentMoves{ 0 };
+        void onIteration(const IterationReport& report) override { iterations.push_back(report); }
+        void onCurrentMove(int, Move, int, uint64_t) override { currentMoves++; }
+    } recorder;
+    searcher.setListener(&recorder);
+    searcher.searchToDepth(4);
+
+    ASSERT_EQ(4U, recorder.iterations.size());
+    for (size_t i = 0; i < recorder.iterations.size(); i++) {
+        const IterationReport& report = recorder.iterations[i];
+        EXPECT_EQ(int(i + 1), report.depth);
+        EXPECT_GT(report.nodes, 0ULL);
+        ASSERT_EQ(1U, report.lines.size());
+        EXPECT_FALSE(report.lines[0].pv.empty());
+    }
+    EXPECT_EQ(searcher.bestMove.moveValue, recorder.iterations.back().lines[0].move.moveValue);
+    EXPECT_GT(recorder.currentMoves, 0);
+}
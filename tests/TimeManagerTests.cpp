@@ -0,0 +1,60 @@
+#include <chrono>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include "Move.h"
+#include "TimeManager.h"
+#include "Types.h"
+
+using namespace SandalBot;
+
+TEST(TimeManager, AllotmentStaysWithinClock) {
+    TimeManager timeManager;
+
+    // Sudden death spreads the clock, and the maximum is a multiple of the optimum
+    timeManager.initClock(60000, 0, 0);
+    EXPECT_EQ(1500, timeManager.optimum());
+    EXPECT_EQ(7500, timeManager.maximum());
+
+    // A large increment on a low clock never allots more than the clock holds
+    timeManager.initClock(500, 2000, 0);
+    EXPECT_LE(timeManager.optimum(), timeManager.maximum());
+    EXPECT_LT(timeManager.maximum(), 500 - TimeManager::defaultMoveOverheadMs);
+
+    // The last move before the time control may use most of the clock
+    timeManager.initClock(10000, 0, 1);
+    EXPECT_GT(timeManager.optimum(), 8000);
+    EXPECT_LT(timeManager.maximum(), 10000 - TimeManager::defaultMoveOverheadMs);
+}
+
+TEST(TimeManager, FixedTimeIgnoresIterations) {
+    TimeManager timeManager;
+    timeManager.setMoveOverhead(0);
+    timeManager.initFixed(1000);
+
+    EXPECT_EQ(1000, timeManager.optimum());
+    EXPECT_EQ(1000, timeManager.maximum());
+    for (int i = 0; i < 10; i++) {
+        EXPECT_FALSE(timeManager.stopAfterIteration(Move(E2, E4, Move::Flag::NO_FLAG), 0));
+    }
+}
+
+TEST(TimeManager, StableBestMoveStopsEarly) {
+    TimeManager timeManager;
+    timeManager.initClock(40000, 0, 0);
+    ASSERT_EQ(1000, timeManager.optimum());
+
+    // Between a quarter and half of the optimum has elapsed, which is only enough once the
+    // optimum is halved by a stable best move
+    std::this_thread::sleep_for(std::chrono::milliseconds(300));
+    Move first(E2, E4, Move::Flag::NO_FLAG);
+    Move second(D2, D4, Move::Flag::NO_FLAG);
+
+    EXPECT_FALSE(timeManager.stopAfterIteration(first, 20));
+    EXPECT_FALSE(timeManager.stopAfterIteration(second, 20));
+    for (int i = 0; i < 3; i++) {
+        EXPECT_FALSE(timeManager.stopAfterIteration(second, 20));
+    }
+    EXPECT_TRUE(timeManager.stopAfterIteration(second, 20));
+}